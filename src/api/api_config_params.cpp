@@ -104,6 +104,8 @@ extern "C" {
         LOG_Z3_update_param_value(c, param_id, param_value);
         RESET_ERROR_CODE();
         mk_c(c)->params().set(param_id, param_value);
+        // pooled solvers were created with the previous parameters.
+        mk_c(c)->reset_solver_pool();
         Z3_CATCH;
     }
 
@@ -19,6 +19,7 @@ Revision History:
 --*/
 #include<typeinfo>
 #include "util/z3_version.h"
+#include "util/gparams.h"
 #include "api/api_context.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -87,6 +88,8 @@ namespace api {
 
         m_error_code = Z3_OK;
         m_print_mode = Z3_PRINT_SMTLIB_FULL;
+        m_pool_created = m_pool_reused = m_pool_returned = m_pool_discarded = 0;
+        m_solver_pool_epoch = 0;
         m_searching  = false;
         
 
@@ -120,6 +123,55 @@ namespace api {
             m_manager.detach();
     }
 
+    /**
+       \brief Key of the solvers in the pool that are created with parameters p.
+       Solvers handed out before the global or context parameters were updated
+       have a different key, so they are not returned to the pool.
+    */
+    std::string context::solver_pool_key(params_ref const & p) const {
+        std::ostringstream strm;
+        p.display(strm);
+        gparams::display_updated(strm);
+        strm << " epoch " << m_solver_pool_epoch;
+        return strm.str();
+    }
+
+    solver_ref context::acquire_pooled_solver(symbol const & logic, std::string const & params) {
+        solver_ref s;
+        for (unsigned i = m_solver_pool.size(); i-- > 0; ) {
+            pooled_solver & e = m_solver_pool[i];
+            if (e.m_logic == logic && e.m_params == params) {
+                s = e.m_solver;
+                std::swap(e, m_solver_pool.back());
+                m_solver_pool.pop_back();
+                m_pool_reused++;
+                break;
+            }
+        }
+        return s;
+    }
+
+    void context::release_pooled_solver(symbol const & logic, std::string const & params, solver * s) {
+        if (m_solver_pool.size() >= m_params.m_solver_pool_size) {
+            m_pool_discarded++;
+            return;
+        }
+        m_solver_pool.push_back(pooled_solver());
+        pooled_solver & e = m_solver_pool.back();
+        e.m_logic = logic;
+        e.m_params = params;
+        e.m_solver = s;
+        m_pool_returned++;
+    }
+
+    void context::collect_solver_pool_statistics(statistics & st) const {
+        st.update("solver pool created", m_pool_created);
+        st.update("solver pool reused", m_pool_reused);
+        st.update("solver pool returned", m_pool_returned);
+        st.update("solver pool discarded", m_pool_discarded);
+        st.update("solver pool idle", m_solver_pool.size());
+    }
+
     context::set_interruptable::set_interruptable(context & ctx, event_handler & i):
         m_ctx(ctx) {
         lock_guard lock(ctx.m_mux);
@@ -251,6 +251,35 @@ namespace api {
         //
         // ------------------------
         smt_params & fparams() { return m_fparams; }
+
+        // ------------------------
+        //
+        // Pool of idle solvers used by Z3_mk_pooled_solver.
+        // Solvers are keyed by logic and by the display of their parameters and of the 
+        // global parameters. The pool is flushed when the context parameters are updated.
+        //
+        // ------------------------
+    private:
+        struct pooled_solver {
+            symbol      m_logic;
+            std::string m_params;
+            solver_ref  m_solver;
+        };
+        vector<pooled_solver>      m_solver_pool;
+        unsigned                   m_pool_created;
+        unsigned                   m_pool_reused;
+        unsigned                   m_pool_returned;
+        unsigned                   m_pool_discarded;
+        unsigned                   m_solver_pool_epoch;     // number of times the pool was flushed
+    public:
+        // Return an idle solver for the given logic and parameters, or nullptr if there is none.
+        solver_ref acquire_pooled_solver(symbol const & logic, std::string const & params);
+        // Return a solver that was reset to its base scope to the pool.
+        void release_pooled_solver(symbol const & logic, std::string const & params, solver * s);
+        void inc_pooled_solvers_created() { m_pool_created++; }
+        void reset_solver_pool() { m_solver_pool.reset(); m_solver_pool_epoch++; }
+        std::string solver_pool_key(params_ref const & p) const;
+        void collect_solver_pool_statistics(statistics & st) const;
         
     };
     
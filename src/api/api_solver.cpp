@@ -17,6 +17,7 @@ Revision History:
 
 --*/
 #include<iostream>
+#include<map>
 #include "util/scoped_ctrl_c.h"
 #include "util/cancel_eh.h"
 #include "util/file_path.h"
@@ -128,6 +129,34 @@ extern "C" {
         if (m_eh) (*m_eh)(API_INTERRUPT_EH_CALLER);
     }
 
+    /**
+       \brief Pop the scopes of a pooled solver and return it to the pool of its context.
+       The solver is dropped instead if its parameters, or the global or context parameters,
+       were changed after it was handed out.
+       Handles that attach state to the solver, such as user propagators or an imported
+       model converter, clear m_pool, so their solver is never returned.
+    */
+    void Z3_solver_ref::release_to_pool() {
+        m_base_stats.reset();
+        if (!m_pool || !m_solver)
+            return;
+        api::context * ctx = m_pool;
+        solver_ref s = m_solver;
+        m_pool = nullptr;
+        m_solver = nullptr;
+        m_base_scopes = 0;
+        if (ctx->solver_pool_key(m_params) != m_pool_params)
+            return;
+        try {
+            s->pop(s->get_scope_level());
+            s->push();
+            ctx->release_pooled_solver(m_logic, m_pool_params, s.get());
+        }
+        catch (z3_exception &) {
+            // the solver is not reusable
+        }
+    }
+
     void Z3_solver_ref::assert_expr(expr * e) {
         if (m_pp) m_pp->assert_expr(e);
         m_solver->assert_expr(e);
@@ -209,6 +238,51 @@ extern "C" {
         Z3_CATCH_RETURN(nullptr);
     }
 
+    Z3_solver Z3_API Z3_mk_pooled_solver(Z3_context c, Z3_symbol logic, Z3_params p) {
+        Z3_TRY;
+        LOG_Z3_mk_pooled_solver(c, logic, p);
+        RESET_ERROR_CODE();
+        symbol l = to_symbol(logic);
+        if (!smt_logics::supported_logic(l)) {
+            std::ostringstream strm;
+            strm << "logic '" << l << "' is not recognized";
+            throw default_exception(strm.str());
+        }
+        Z3_solver_ref * s = alloc(Z3_solver_ref, *mk_c(c), mk_smt_strategic_solver_factory(l));
+        // saving s first releases the previously returned object, which may be a pooled solver.
+        mk_c(c)->save_object(s);
+        s->m_params = to_param_ref(p);
+        s->m_logic = l;
+        s->m_pool_params = mk_c(c)->solver_pool_key(s->m_params);
+        Z3_solver r = of_solver(s);
+        s->m_solver = mk_c(c)->acquire_pooled_solver(l, s->m_pool_params);
+        if (s->m_solver) 
+            s->m_solver->collect_statistics(s->m_base_stats);
+        else {
+            init_solver_core(c, r);
+            // assertions made by the user go into a scope that can be popped when the solver is returned.
+            s->m_solver->push();
+            mk_c(c)->inc_pooled_solvers_created();
+        }
+        s->m_pool = mk_c(c);
+        s->m_base_scopes = 1;
+        init_solver_log(c, r);
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    Z3_stats Z3_API Z3_get_solver_pool_statistics(Z3_context c) {
+        Z3_TRY;
+        LOG_Z3_get_solver_pool_statistics(c);
+        RESET_ERROR_CODE();
+        Z3_stats_ref * st = alloc(Z3_stats_ref, *mk_c(c));
+        mk_c(c)->collect_solver_pool_statistics(st->m_stats);
+        mk_c(c)->save_object(st);
+        Z3_stats r = of_stats(st);
+        RETURN_Z3(r);
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_solver Z3_API Z3_mk_solver_from_tactic(Z3_context c, Z3_tactic t) {
         Z3_TRY;
         LOG_Z3_mk_solver_from_tactic(c, t);
@@ -242,6 +316,7 @@ extern "C" {
         LOG_Z3_solver_import_model_converter(c, src, dst);
         model_converter_ref mc = to_solver_ref(src)->get_model_converter();
         to_solver_ref(dst)->set_model_converter(mc.get());
+        to_solver(dst)->m_pool = nullptr;
         Z3_CATCH;
     }
 
@@ -425,7 +500,7 @@ extern "C" {
         LOG_Z3_solver_pop(c, s, n);
         RESET_ERROR_CODE();
         init_solver(c, s);
-        if (n > to_solver_ref(s)->get_scope_level()) {
+        if (n > to_solver(s)->get_scope_level()) {
             SET_ERROR_CODE(Z3_IOB, nullptr);
             return;
         }
@@ -440,6 +515,9 @@ extern "C" {
         Z3_TRY;
         LOG_Z3_solver_reset(c, s);
         RESET_ERROR_CODE();
+        // the solver is not reset in place with smt.fast_reset: it is created by a 
+        // solver factory and need not wrap an smt::kernel. Pooled solvers are reused.
+        to_solver(s)->release_to_pool();
         to_solver(s)->m_solver = nullptr;
         if (to_solver(s)->m_pp) to_solver(s)->m_pp->reset();
         Z3_CATCH;
@@ -450,7 +528,7 @@ extern "C" {
         LOG_Z3_solver_get_num_scopes(c, s);
         RESET_ERROR_CODE();
         init_solver(c, s);
-        return to_solver_ref(s)->get_scope_level();
+        return to_solver(s)->get_scope_level();
         Z3_CATCH_RETURN(0);
     }
     
@@ -687,6 +765,41 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
     
+    /**
+       \brief Subtract the statistics in base from st.
+       Used for pooled solvers, whose statistics are reported from the time they were handed out.
+    */
+    static void subtract_statistics(statistics const & base, statistics & st) {
+        std::map<std::string, unsigned> ubase;
+        std::map<std::string, double> dbase;
+        for (unsigned i = 0; i < base.size(); ++i) {
+            if (base.is_uint(i))
+                ubase[base.get_key(i)] += base.get_uint_value(i);
+            else
+                dbase[base.get_key(i)] += base.get_double_value(i);
+        }
+        statistics result;
+        for (unsigned i = 0; i < st.size(); ++i) {
+            char const * k = st.get_key(i);
+            if (st.is_uint(i)) {
+                unsigned v = st.get_uint_value(i);
+                unsigned & b = ubase[k];
+                unsigned d = std::min(v, b);
+                b -= d;
+                result.update(k, v - d);
+            }
+            else {
+                double v = st.get_double_value(i);
+                double & b = dbase[k];
+                double d = std::min(v, b);
+                b -= d;
+                result.update(k, v - d);
+            }
+        }
+        st.reset();
+        st.copy(result);
+    }
+
     Z3_stats Z3_API Z3_solver_get_statistics(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_statistics(c, s);
@@ -694,6 +807,8 @@ extern "C" {
         init_solver(c, s);
         Z3_stats_ref * st = alloc(Z3_stats_ref, *mk_c(c));
         to_solver_ref(s)->collect_statistics(st->m_stats);
+        if (to_solver(s)->m_base_stats.size() > 0)
+            subtract_statistics(to_solver(s)->m_base_stats, st->m_stats);
         get_memory_statistics(st->m_stats);
         get_rlimit_statistics(mk_c(c)->m().limit(), st->m_stats);
         to_solver_ref(s)->collect_timer_stats(st->m_stats);
@@ -883,6 +998,7 @@ extern "C" {
             return fresh_eh(user_ctx, reinterpret_cast<Z3_context>(ctx));
         };
         to_solver_ref(s)->user_propagate_init(user_context, _push, _pop, _fresh);
+        to_solver(s)->m_pool = nullptr;
         Z3_CATCH;
     }
 
@@ -894,6 +1010,7 @@ extern "C" {
         RESET_ERROR_CODE();
         solver::fixed_eh_t _fixed = (void(*)(void*,solver::propagate_callback*,unsigned,expr*))fixed_eh; 
         to_solver_ref(s)->user_propagate_register_fixed(_fixed);
+        to_solver(s)->m_pool = nullptr;
         Z3_CATCH;        
     }
 
@@ -905,6 +1022,7 @@ extern "C" {
         RESET_ERROR_CODE();
         solver::final_eh_t _final = (bool(*)(void*,solver::propagate_callback*))final_eh;
         to_solver_ref(s)->user_propagate_register_final(_final);
+        to_solver(s)->m_pool = nullptr;
         Z3_CATCH;        
     }
 
@@ -916,6 +1034,7 @@ extern "C" {
         RESET_ERROR_CODE();
         solver::eq_eh_t _eq = (void(*)(void*,solver::propagate_callback*,unsigned,unsigned))eq_eh;
         to_solver_ref(s)->user_propagate_register_eq(_eq);
+        to_solver(s)->m_pool = nullptr;
         Z3_CATCH;        
     }
 
@@ -927,6 +1046,7 @@ extern "C" {
         RESET_ERROR_CODE();
         solver::eq_eh_t _diseq = (void(*)(void*,solver::propagate_callback*,unsigned,unsigned))diseq_eh;
         to_solver_ref(s)->user_propagate_register_diseq(_diseq);
+        to_solver(s)->m_pool = nullptr;
         Z3_CATCH;        
     }
 
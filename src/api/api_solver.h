@@ -46,15 +46,22 @@ struct Z3_solver_ref : public api::object {
     scoped_ptr<solver2smt2_pp> m_pp;
     mutex                      m_mux;
     event_handler*             m_eh;
+    api::context*              m_pool;          // context owning the pool m_solver came from, if any
+    std::string                m_pool_params;   // key m_solver was pooled under, see api::context::solver_pool_key
+    unsigned                   m_base_scopes;   // scopes pushed by the pool, hidden from the user
+    statistics                 m_base_stats;    // statistics of a pooled solver when it was handed out
 
     Z3_solver_ref(api::context& c, solver_factory * f): 
-        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
-    ~Z3_solver_ref() override {}
+        api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr),
+        m_pool(nullptr), m_base_scopes(0) {}
+    ~Z3_solver_ref() override { release_to_pool(); }
 
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
     void set_eh(event_handler* eh);
     void set_cancel();
+    void release_to_pool();
+    unsigned get_scope_level() const { return m_solver->get_scope_level() - m_base_scopes; }
 
 };
 
@@ -421,7 +421,7 @@ extern "C" {
             scoped_ctrl_c ctrlc(eh, false, use_ctrl_c);
             scoped_timer timer(timeout, &eh);
             try {
-                exec(*to_tactic_ref(t), new_goal, ref->m_subgoals);
+                exec(*to_tactic_ref(t), new_goal, ref->m_subgoals, p);
                 ref->m_pc = new_goal->pc();
                 ref->m_mc = new_goal->mc();
                 return of_apply_result(ref);
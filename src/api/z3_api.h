@@ -6282,6 +6282,41 @@ extern "C" {
     */
     Z3_solver Z3_API Z3_mk_solver_for_logic(Z3_context c, Z3_symbol logic);
 
+    /**
+       \brief Create a solver for the given logic and parameters, reusing an idle solver of the context if possible.
+
+       When a pooled solver is deleted or reset, its assertions are popped and it is returned
+       to the pool of the context. A later call with the same logic and parameters hands out
+       the same solver again, so it does not have to be created and configured from scratch.
+       Solvers whose parameters were changed with #Z3_solver_set_params are not returned to the pool,
+       and neither are solvers with user propagators or an imported model converter.
+       Solvers are only reused under the global parameters they were created with, and
+       #Z3_update_param_value empties the pool. The context parameter \c solver_pool_size
+       bounds the number of idle solvers in the pool.
+       The statistics of a pooled solver only count the work done since it was handed out.
+
+       Pooled solvers always run in incremental mode.
+
+       \remark User must use #Z3_solver_inc_ref and #Z3_solver_dec_ref to manage solver objects.
+       Even if the context was created using #Z3_mk_context instead of #Z3_mk_context_rc.
+
+       \sa Z3_get_solver_pool_statistics
+
+       def_API('Z3_mk_pooled_solver', SOLVER, (_in(CONTEXT), _in(SYMBOL), _in(PARAMS)))
+    */
+    Z3_solver Z3_API Z3_mk_pooled_solver(Z3_context c, Z3_symbol logic, Z3_params p);
+
+    /**
+       \brief Return statistics for the solver pool of the context:
+       the number of solvers created, reused, returned to and discarded from the pool,
+       and the number of idle solvers.
+
+       \sa Z3_mk_pooled_solver
+
+       def_API('Z3_get_solver_pool_statistics', STATS, (_in(CONTEXT),))
+    */
+    Z3_stats Z3_API Z3_get_solver_pool_statistics(Z3_context c);
+
     /**
        \brief Create a new solver that is implemented using the given tactic.
        The solver supports the commands #Z3_solver_push and #Z3_solver_pop, but it
@@ -1677,6 +1677,11 @@ public:
 
     unsigned get_num_asts() const { return m_ast_table.size(); }
 
+    /**
+       \brief Return N such that the ids of all expressions created so far are in [0..N)
+    */
+    unsigned get_expr_id_range() const { return m_expr_id_gen.get_id_range(); }
+
     void debug_ref_count() { m_debug_ref_count = true; }
 
     void inc_ref(ast* n) {
@@ -56,8 +56,8 @@ public:
     ast_manager & m() const { return Cfg::m(); }
     numeral power(unsigned n) const { return Cfg::power(n); }
     void mk_xor(expr * a, expr * b, expr_ref & r) { Cfg::mk_xor(a, b, r); }
-    void mk_xor3(expr * a, expr * b, expr * c, expr_ref & r) { Cfg::mk_xor3(a, b, c, r); }
-    void mk_carry(expr * a, expr * b, expr * c, expr_ref & r) { Cfg::mk_carry(a, b, c, r); }
+    void mk_xor3(expr * a, expr * b, expr * c, expr_ref & r);
+    void mk_carry(expr * a, expr * b, expr * c, expr_ref & r);
     void mk_iff(expr * a, expr * b, expr_ref & r) { Cfg::mk_iff(a, b, r); }
     void mk_and(expr * a, expr * b, expr_ref & r) { Cfg::mk_and(a, b, r); }
     void mk_and(expr * a, expr * b, expr * c, expr_ref & r) { Cfg::mk_and(a, b, c, r); }
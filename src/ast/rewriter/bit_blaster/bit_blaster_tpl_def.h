@@ -103,6 +103,64 @@ void bit_blaster_tpl<Cfg>::num2bits(numeral const & v, unsigned sz, expr_ref_vec
     _num2bits(m(), v, sz, out_bits);
 }
 
+/**
+   \brief Fold constant, shared and complementary inputs of the xor3 and carry
+   gates before delegating to Cfg. Adder chains and multiplier arrays produce
+   many such gates, and folding them here avoids creating nodes that only
+   simplify after bit-blasting.
+*/
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_xor3(expr * a, expr * b, expr * c, expr_ref & r) {
+    if (m().is_false(a))
+        mk_xor(b, c, r);
+    else if (m().is_false(b))
+        mk_xor(a, c, r);
+    else if (m().is_false(c))
+        mk_xor(a, b, r);
+    else if (a == b)
+        r = c;
+    else if (a == c)
+        r = b;
+    else if (b == c)
+        r = a;
+    else if (m().is_complement(a, b))
+        mk_not(c, r);
+    else if (m().is_complement(a, c))
+        mk_not(b, r);
+    else if (m().is_complement(b, c))
+        mk_not(a, r);
+    else
+        Cfg::mk_xor3(a, b, c, r);
+}
+
+template<typename Cfg>
+void bit_blaster_tpl<Cfg>::mk_carry(expr * a, expr * b, expr * c, expr_ref & r) {
+    if (m().is_false(a))
+        mk_and(b, c, r);
+    else if (m().is_false(b))
+        mk_and(a, c, r);
+    else if (m().is_false(c))
+        mk_and(a, b, r);
+    else if (m().is_true(a))
+        mk_or(b, c, r);
+    else if (m().is_true(b))
+        mk_or(a, c, r);
+    else if (m().is_true(c))
+        mk_or(a, b, r);
+    else if (a == b || a == c)
+        r = a;
+    else if (b == c)
+        r = b;
+    else if (m().is_complement(a, b))
+        r = c;
+    else if (m().is_complement(a, c))
+        r = b;
+    else if (m().is_complement(b, c))
+        r = a;
+    else
+        Cfg::mk_carry(a, b, c, r);
+}
+
 template<typename Cfg>
 void bit_blaster_tpl<Cfg>::mk_half_adder(expr * a, expr * b, expr_ref & out, expr_ref & cout) {
     mk_xor(a, b, out);
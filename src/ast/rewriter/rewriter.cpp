@@ -192,7 +192,9 @@ rewriter_core::rewriter_core(ast_manager & m, bool proof_gen):
     m_cancel_check(true),
     m_result_stack(m),
     m_result_pr_stack(m),
-    m_num_qvars(0) {
+    m_num_qvars(0),
+    m_cache_hits(0),
+    m_cache_misses(0) {
     init_cache_stack();
 }
 
@@ -213,6 +215,21 @@ void rewriter_core::reset() {
     m_scopes.reset();
 }
 
+// reset rewriter, but keep the results cached outside of quantifiers for the next call.
+void rewriter_core::reset_keep_cache() {
+    SASSERT(!m_cache_stack.empty());
+    m_cache = m_cache_stack[0];
+    if (m_proof_gen)
+        m_cache_pr = m_cache_pr_stack[0];
+    m_frame_stack.reset();
+    m_result_stack.reset();
+    if (m_proof_gen)
+        m_result_pr_stack.reset();
+    m_root = nullptr;
+    m_num_qvars = 0;
+    m_scopes.reset();
+}
+
 // free memory & reset (macro definitions are not erased)
 void rewriter_core::cleanup() {
     free_memory();
@@ -68,6 +68,8 @@ protected:
         scope(expr * r, unsigned n):m_old_root(r), m_old_num_qvars(n) {}
     };
     svector<scope>             m_scopes;
+    unsigned                   m_cache_hits;
+    unsigned                   m_cache_misses;
 
     // Return true if the rewriting result of the given expression must be cached.
     bool must_cache(expr * t) const {
@@ -117,12 +119,15 @@ public:
     virtual ~rewriter_core();
     ast_manager & m() const { return m_manager; }
     void reset();
+    void reset_keep_cache();
     void cleanup();
     void set_cancel_check(bool f) { m_cancel_check = f; }
 #ifdef _TRACE
     void display_stack(std::ostream & out, unsigned pp_depth);
 #endif
     unsigned get_cache_size() const;
+    unsigned get_cache_hits() const { return m_cache_hits; }
+    unsigned get_cache_misses() const { return m_cache_misses; }
 };
 
 class var_shifter_core : public rewriter_core {
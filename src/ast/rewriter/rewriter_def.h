@@ -170,7 +170,11 @@ bool rewriter_tpl<Config>::visit(expr * t, unsigned max_depth) {
             std::cerr << "[rewriter] num-cache-checks: " << checked_cache << std::endl;
 #endif
         expr * r = get_cached(t);
-        if (r) {
+        if (!r) {
+            ++m_cache_misses;
+        }
+        else {
+            ++m_cache_hits;
             SASSERT(m().get_sort(r) == m().get_sort(t));
             result_stack().push_back(r);
             set_new_child_flag(t, r);
@@ -811,9 +811,44 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
 
 struct th_rewriter::imp : public rewriter_tpl<th_rewriter_cfg> {
     th_rewriter_cfg m_cfg;
+    bool            m_persistent;
+    unsigned        m_max_cache_size;
+    bool            m_cache_dirty;   // cache may contain results that depend on bindings or substitutions
+    unsigned        m_cache_flushes;
     imp(ast_manager & m, params_ref const & p):
         rewriter_tpl<th_rewriter_cfg>(m, m.proofs_enabled(), m_cfg),
-        m_cfg(m, p) {
+        m_cfg(m, p),
+        m_cache_dirty(false),
+        m_cache_flushes(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & _p) {
+        rewriter_params p(_p);
+        m_persistent     = p.cache_persistent();
+        m_max_cache_size = p.cache_max_size();
+    }
+
+    void flush() {
+        if (get_cache_size() > 0)
+            ++m_cache_flushes;
+        rewriter_tpl<th_rewriter_cfg>::reset();
+        m_cache_dirty = false;
+    }
+
+    /**
+       \brief reset the rewriter between top-level calls. 
+       A persistent cache survives unless it may contain results that depend on 
+       bindings or substitutions, or it exceeds the size bound.
+    */
+    void reset_between_calls() {
+        if (m_persistent && !m_cache_dirty && !m_cfg.m_subst && get_cache_size() <= m_max_cache_size) {
+            reset_keep_cache();
+            m_bindings.reset();
+            m_shifts.reset();
+        }
+        else 
+            flush();
     }
     expr_ref mk_app(func_decl* f, unsigned sz, expr* const* args) {
         return m_cfg.mk_app(f, sz, args);
@@ -836,6 +871,8 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params = p;
     m_imp->cfg().updt_params(p);
+    m_imp->updt_params(p);
+    m_imp->flush();
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -866,10 +903,16 @@ void th_rewriter::cleanup() {
 }
 
 void th_rewriter::reset() {
-    m_imp->reset();
+    m_imp->reset_between_calls();
     m_imp->cfg().reset();
 }
 
+void th_rewriter::collect_statistics(statistics & st) const {
+    st.update("rewriter cache hits", m_imp->get_cache_hits());
+    st.update("rewriter cache misses", m_imp->get_cache_misses());
+    st.update("rewriter cache flushes", m_imp->m_cache_flushes);
+}
+
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
     m_imp->operator()(term, result);
@@ -885,6 +928,7 @@ void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr)
 }
 
 expr_ref th_rewriter::operator()(expr * n, unsigned num_bindings, expr * const * bindings) {
+    m_imp->m_cache_dirty = true;
     return m_imp->operator()(n, num_bindings, bindings);
 }
 
@@ -909,6 +953,7 @@ expr_ref th_rewriter::mk_app(func_decl* f, unsigned num_args, expr* const* args)
 }
 
 void th_rewriter::set_solver(expr_solver* solver) {
+    m_imp->flush();
     m_imp->set_solver(solver);
 }
 
@@ -21,6 +21,7 @@ Notes:
 #include "ast/ast.h"
 #include "ast/rewriter/rewriter_types.h"
 #include "util/params.h"
+#include "util/statistics.h"
 
 class expr_substitution;
 
@@ -40,6 +41,7 @@ public:
     static void get_param_descrs(param_descrs & r);
     unsigned get_cache_size() const;
     unsigned get_num_steps() const;
+    void collect_statistics(statistics & st) const;
    
     void operator()(expr_ref& term);
     void operator()(expr * t, expr_ref & result);
@@ -45,6 +45,8 @@ namespace dd {
 
         m_spare_entry = nullptr;
         m_max_num_bdd_nodes = 1 << 24; // up to 16M nodes
+        m_max_cache_size = 1 << 20; // up to 1M cached operations
+        m_cache_stamp = 0;
         m_mark_level = 0;
         alloc_free_nodes(1024 + num_vars);
         m_disable_gc = false;
@@ -108,9 +110,11 @@ namespace dd {
     bdd bdd_manager::mk_forall(unsigned v, bdd const& b) { return mk_forall(1, &v, b); }
 
 
-    bool bdd_manager::check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c) {
+    bool bdd_manager::check_result(op_entry*& e1, op_entry* e2, BDD a, BDD b, BDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_bdd);
+            e2->m_stamp = m_cache_stamp;
+            m_stats.m_num_cache_hits++;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -119,6 +123,8 @@ namespace dd {
             e1->m_bdd1 = a;
             e1->m_bdd2 = b;
             e1->m_op = c;
+            e1->m_stamp = m_cache_stamp;
+            m_stats.m_num_cache_misses++;
             SASSERT(e1->m_result == null_bdd);
             return false;        
         }
@@ -151,7 +157,7 @@ namespace dd {
             return m_apply_const[a + 2*b + 4*op];
         }
         op_entry * e1 = pop_entry(a, b, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+        op_entry* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, a, b, op)) {
             SASSERT(!m_free_nodes.contains(e2->m_result));
             return e2->m_result;
@@ -193,6 +199,8 @@ namespace dd {
     }
 
     bdd_manager::op_entry* bdd_manager::pop_entry(BDD l, BDD r, BDD op) {
+        if (m_op_cache.size() >= m_max_cache_size) 
+            evict_op_cache();
         op_entry* result = nullptr;
         if (m_spare_entry) {
             result = m_spare_entry;
@@ -214,6 +222,39 @@ namespace dd {
         m_spare_entry = e;
     }
 
+    /**
+     * Evict cache entries that were not used since the previous eviction,
+     * or all completed entries if recently used entries fill more than half of the cache.
+     * Entries of operations in progress have no result yet and are retained.
+     */
+    void bdd_manager::evict_op_cache() {
+        ptr_vector<op_entry> to_delete, to_keep;
+        for (auto* e : m_op_cache) {
+            if (e->m_result != null_bdd && e->m_stamp != m_cache_stamp) 
+                to_delete.push_back(e);
+            else
+                to_keep.push_back(e);
+        }
+        if (2 * to_keep.size() > m_max_cache_size) {
+            unsigned j = 0;
+            for (op_entry* e : to_keep) {
+                if (e->m_result != null_bdd)
+                    to_delete.push_back(e);
+                else
+                    to_keep[j++] = e;
+            }
+            to_keep.shrink(j);
+        }
+        IF_VERBOSE(13, verbose_stream() << "(bdd :evict " << to_delete.size() << " :keep " << to_keep.size() << ")\n";);
+        m_stats.m_num_cache_evictions += to_delete.size();
+        m_op_cache.reset();
+        for (op_entry* e : to_delete) 
+            m_alloc.deallocate(sizeof(*e), e);
+        for (op_entry* e : to_keep) 
+            m_op_cache.insert(e);
+        ++m_cache_stamp;
+    }
+
     bdd_manager::BDD bdd_manager::make_node(unsigned lvl, BDD l, BDD h) {
         m_is_new_node = false;
         if (l == h) {
@@ -561,7 +602,7 @@ namespace dd {
         if (is_true(b)) return false_bdd;
         if (is_false(b)) return true_bdd;
         op_entry* e1 = pop_entry(b, b, bdd_not_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+        op_entry* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, b, b, bdd_not_op)) 
             return e2->m_result;
         push(mk_not_rec(lo(b)));
@@ -597,7 +638,7 @@ namespace dd {
         if (is_true(c)) return apply(mk_not_rec(a), b, bdd_or_op);
         SASSERT(!is_const(a) && !is_const(b) && !is_const(c));
         op_entry * e1 = pop_entry(a, b, c);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+        op_entry* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, a, b, c)) 
             return e2->m_result;
         unsigned la = level(a), lb = level(b), lc = level(c);
@@ -666,7 +707,7 @@ namespace dd {
             BDD a = level2bdd(l);
             bdd_op q_op = op == bdd_and_op ? bdd_and_proj_op : bdd_or_proj_op;
             op_entry * e1 = pop_entry(a, b, q_op);
-            op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+            op_entry* e2 = m_op_cache.insert_if_not_there(e1);
             if (check_result(e1, e2, a, b, q_op)) {
                 r = e2->m_result;
             }
@@ -748,6 +789,7 @@ namespace dd {
     void bdd_manager::gc() {
         m_free_nodes.reset();
         IF_VERBOSE(13, verbose_stream() << "(bdd :gc " << m_nodes.size() << ")\n";);
+        m_stats.m_num_gc++;
         bool_vector reachable(m_nodes.size(), false);
         for (unsigned i = m_bdd_stack.size(); i-- > 0; ) {
             reachable[m_bdd_stack[i]] = true;
@@ -892,6 +934,15 @@ namespace dd {
         return out;
     }
 
+    void bdd_manager::collect_statistics(statistics& st) const {
+        st.update("dd.bdd.nodes", m_nodes.size());
+        st.update("dd.bdd.gc", m_stats.m_num_gc);
+        st.update("dd.bdd.cache-size", m_op_cache.size());
+        st.update("dd.bdd.cache-hits", m_stats.m_num_cache_hits);
+        st.update("dd.bdd.cache-misses", m_stats.m_num_cache_misses);
+        st.update("dd.bdd.cache-evictions", m_stats.m_num_cache_evictions);
+    }
+
     bdd& bdd::operator=(bdd const& other) { unsigned r1 = root; root = other.root; m->inc_ref(root); m->dec_ref(r1); return *this; }
     std::ostream& operator<<(std::ostream& out, bdd const& b) { return b.display(out); }
 
@@ -21,6 +21,8 @@ Revision History:
 #include "util/vector.h"
 #include "util/map.h"
 #include "util/small_object_allocator.h"
+#include "util/statistics.h"
+#include <cstring>
 
 namespace dd {
 
@@ -85,13 +87,15 @@ namespace dd {
                 m_bdd1(l),
                 m_bdd2(r),
                 m_op(op),
-                m_result(0)
+                m_result(0),
+                m_stamp(0)
             {}
 
             BDD      m_bdd1;
             BDD      m_bdd2;
             BDD      m_op;
             BDD      m_result;
+            unsigned m_stamp;  // cache epoch of last use, for eviction
             unsigned hash() const { return mk_mix(m_bdd1, m_bdd2, m_op); }
         };
 
@@ -101,12 +105,21 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
+                return a->m_bdd1 == b->m_bdd1 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
             }
         };
 
         typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
 
+        struct stats {
+            unsigned m_num_gc;
+            unsigned m_num_cache_hits;
+            unsigned m_num_cache_misses;
+            unsigned m_num_cache_evictions;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
         svector<bdd_node>          m_nodes;
         op_table                   m_op_cache;
         node_table                 m_node_table;
@@ -124,6 +137,9 @@ namespace dd {
         bool                       m_disable_gc;
         bool                       m_is_new_node;
         unsigned                   m_max_num_bdd_nodes;
+        unsigned                   m_max_cache_size;
+        unsigned                   m_cache_stamp;
+        stats                      m_stats;
         unsigned_vector            m_S, m_T, m_to_free;  // used for reordering
         vector<unsigned_vector>    m_level2nodes;
         unsigned_vector            m_reorder_rc;
@@ -148,7 +164,8 @@ namespace dd {
 
         op_entry* pop_entry(BDD l, BDD r, BDD op);
         void push_entry(op_entry* e);
-        bool check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c);
+        bool check_result(op_entry*& e1, op_entry* e2, BDD a, BDD b, BDD c);
+        void evict_op_cache();
         
         double count(BDD b, unsigned z);
 
@@ -206,6 +223,8 @@ namespace dd {
         ~bdd_manager();
 
         void set_max_num_nodes(unsigned n) { m_max_num_bdd_nodes = n; }
+        // bound the number of entries in the operation cache, least recently used entries are evicted first.
+        void set_max_cache_size(unsigned n) { m_max_cache_size = std::max(n, 2u); }
 
         bdd mk_var(unsigned i);
         bdd mk_nvar(unsigned i);
@@ -225,6 +244,9 @@ namespace dd {
         void gc();
         void try_reorder();
         void try_cnf_reorder(bdd const& b);
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics() { m_stats.reset(); }
     };
 
     class bdd {
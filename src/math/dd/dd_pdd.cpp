@@ -26,6 +26,8 @@ namespace dd {
     pdd_manager::pdd_manager(unsigned num_vars, semantics s) {
         m_spare_entry = nullptr;
         m_max_num_nodes = 1 << 24; // up to 16M nodes
+        m_max_cache_size = 1 << 20; // up to 1M cached operations
+        m_cache_stamp = 0;
         m_mark_level = 0;
         m_dmark_level = 0;
         m_disable_gc = false;
@@ -93,6 +95,40 @@ namespace dd {
         m_op_cache.reset();
     }
 
+    /**
+     * Evict cache entries that were not used since the previous eviction.
+     * If the recently used entries still fill more than half of the cache,
+     * evict all completed entries. Entries without a result belong to 
+     * operations that are in progress and are retained.
+     */
+    void pdd_manager::evict_op_cache() {
+        ptr_vector<op_entry> to_delete, to_keep;
+        for (auto* e : m_op_cache) {
+            if (e->m_result != null_pdd && e->m_stamp != m_cache_stamp) 
+                to_delete.push_back(e);
+            else
+                to_keep.push_back(e);
+        }
+        if (2 * to_keep.size() > m_max_cache_size) {
+            unsigned j = 0;
+            for (op_entry* e : to_keep) {
+                if (e->m_result != null_pdd)
+                    to_delete.push_back(e);
+                else
+                    to_keep[j++] = e;
+            }
+            to_keep.shrink(j);
+        }
+        IF_VERBOSE(13, verbose_stream() << "(pdd :evict " << to_delete.size() << " :keep " << to_keep.size() << ")\n";);
+        m_stats.m_num_cache_evictions += to_delete.size();
+        m_op_cache.reset();
+        for (op_entry* e : to_delete) 
+            m_alloc.deallocate(sizeof(*e), e);
+        for (op_entry* e : to_keep) 
+            m_op_cache.insert(e);
+        ++m_cache_stamp;
+    }
+
     pdd pdd_manager::add(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_add_op), this); }
     pdd pdd_manager::sub(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_sub_op), this); }
     pdd pdd_manager::mul(pdd const& a, pdd const& b) { return pdd(apply(a.root, b.root, pdd_mul_op), this); }
@@ -140,9 +176,11 @@ namespace dd {
         return null_pdd;
     }
 
-    bool pdd_manager::check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c) {
+    bool pdd_manager::check_result(op_entry*& e1, op_entry* e2, PDD a, PDD b, PDD c) {
         if (e1 != e2) {
             SASSERT(e2->m_result != null_pdd);
+            e2->m_stamp = m_cache_stamp;
+            m_stats.m_num_cache_hits++;
             push_entry(e1);
             e1 = nullptr;
             return true;            
@@ -151,6 +189,8 @@ namespace dd {
             e1->m_pdd1 = a;
             e1->m_pdd2 = b;
             e1->m_op = c;
+            e1->m_stamp = m_cache_stamp;
+            m_stats.m_num_cache_misses++;
             SASSERT(e1->m_result == null_pdd);
             return false;        
         }
@@ -198,7 +238,7 @@ namespace dd {
         }
 
         op_entry * e1 = pop_entry(p, q, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+        op_entry* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, p, q, op)) {
             SASSERT(!m_free_nodes.contains(e2->m_result));
             return e2->m_result;
@@ -378,7 +418,7 @@ namespace dd {
         if (is_zero(a)) return zero_pdd;
         if (is_val(a)) return imk_val(-val(a));
         op_entry* e1 = pop_entry(a, a, pdd_minus_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
+        op_entry* e2 = m_op_cache.insert_if_not_there(e1);
         if (check_result(e1, e2, a, a, pdd_minus_op)) 
             return e2->m_result;
         push(minus_rec(lo(a)));
@@ -699,6 +739,8 @@ namespace dd {
     }
 
     pdd_manager::op_entry* pdd_manager::pop_entry(PDD l, PDD r, PDD op) {
+        if (m_op_cache.size() >= m_max_cache_size) 
+            evict_op_cache();
         op_entry* result = nullptr;
         if (m_spare_entry) {
             result = m_spare_entry;
@@ -783,7 +825,8 @@ namespace dd {
             e = m_node_table.insert_if_not_there2(n);
             e->get_data().m_refcount = 0;      
         }
-        if (do_gc) {
+        // grow the node table only if garbage collection reclaimed less than a third of the nodes
+        if (do_gc && m_free_nodes.size()*3 < m_nodes.size()) {
             if (m_nodes.size() > m_max_num_nodes) {
                 throw mem_out();
             }
@@ -994,6 +1037,7 @@ namespace dd {
         m_free_nodes.reset();
         SASSERT(well_formed());
         IF_VERBOSE(13, verbose_stream() << "(pdd :gc " << m_nodes.size() << ")\n";);
+        m_stats.m_num_gc++;
         bool_vector reachable(m_nodes.size(), false);
         compute_reachable(reachable);
         for (unsigned i = m_nodes.size(); i-- > pdd_no_op; ) {
@@ -1146,6 +1190,15 @@ namespace dd {
         return out;
     }
 
+    void pdd_manager::collect_statistics(statistics& st) const {
+        st.update("dd.pdd.nodes", m_nodes.size());
+        st.update("dd.pdd.gc", m_stats.m_num_gc);
+        st.update("dd.pdd.cache-size", m_op_cache.size());
+        st.update("dd.pdd.cache-hits", m_stats.m_num_cache_hits);
+        st.update("dd.pdd.cache-misses", m_stats.m_num_cache_misses);
+        st.update("dd.pdd.cache-evictions", m_stats.m_num_cache_evictions);
+    }
+
     pdd& pdd::operator=(pdd const& other) { 
         unsigned r1 = root; 
         root = other.root; 
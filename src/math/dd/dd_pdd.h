@@ -34,6 +34,8 @@ Author:
 #include "util/map.h"
 #include "util/small_object_allocator.h"
 #include "util/rational.h"
+#include "util/statistics.h"
+#include <cstring>
 
 namespace dd {
     class test;
@@ -118,13 +120,15 @@ namespace dd {
                 m_pdd1(l),
                 m_pdd2(r),
                 m_op(op),
-                m_result(0)
+                m_result(0),
+                m_stamp(0)
             {}
 
             PDD      m_pdd1;
             PDD      m_pdd2;
             PDD      m_op;
             PDD      m_result;
+            unsigned m_stamp;  // cache epoch of last use, for eviction
             unsigned hash() const { return mk_mix(m_pdd1, m_pdd2, m_op); }
         };
 
@@ -134,12 +138,21 @@ namespace dd {
 
         struct eq_entry {
             bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_pdd1 == b->m_pdd2 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
+                return a->m_pdd1 == b->m_pdd1 && a->m_pdd2 == b->m_pdd2 && a->m_op == b->m_op;
             }
         };
 
         typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
 
+        struct stats {
+            unsigned m_num_gc;
+            unsigned m_num_cache_hits;
+            unsigned m_num_cache_misses;
+            unsigned m_num_cache_evictions;
+            stats() { reset(); }
+            void reset() { memset(this, 0, sizeof(*this)); }
+        };
+
         svector<node>          m_nodes;
         vector<rational>           m_values;
         op_table                   m_op_cache;
@@ -159,12 +172,16 @@ namespace dd {
         bool                       m_disable_gc;
         bool                       m_is_new_node;
         unsigned                   m_max_num_nodes;
+        unsigned                   m_max_cache_size;
+        unsigned                   m_cache_stamp;
+        stats                      m_stats;
         semantics                  m_semantics;
         unsigned_vector            m_free_vars;
         unsigned_vector            m_free_values;
         rational                   m_freeze_value;
 
         void reset_op_cache();
+        void evict_op_cache();
         void init_nodes(unsigned_vector const& l2v);
         void init_vars(unsigned_vector const& l2v);
 
@@ -191,7 +208,7 @@ namespace dd {
 
         op_entry* pop_entry(PDD l, PDD r, PDD op);
         void push_entry(op_entry* e);
-        bool check_result(op_entry*& e1, op_entry const* e2, PDD a, PDD b, PDD c);
+        bool check_result(op_entry*& e1, op_entry* e2, PDD a, PDD b, PDD c);
         
         void alloc_free_nodes(unsigned n);
         void init_mark();
@@ -259,6 +276,8 @@ namespace dd {
 
         void reset(unsigned_vector const& level2var);
         void set_max_num_nodes(unsigned n) { m_max_num_nodes = n; }
+        // bound the number of entries in the operation cache, least recently used entries are evicted first.
+        void set_max_cache_size(unsigned n) { m_max_cache_size = std::max(n, 2u); }
         unsigned_vector const& get_level2var() const { return m_level2var; }
 
         pdd mk_var(unsigned i);
@@ -306,6 +325,9 @@ namespace dd {
         std::ostream& display(std::ostream& out, pdd const& b);
 
         void gc();
+
+        void collect_statistics(statistics& st) const;
+        void reset_statistics() { m_stats.reset(); }
     };
 
     class pdd {
@@ -434,6 +434,7 @@ namespace dd {
         st.update("dd.solver.to_simplify", m_to_simplify.size());
         st.update("dd.solver.degree", m_stats.m_max_expr_degree);
         st.update("dd.solver.size", m_stats.m_max_expr_size);
+        m.collect_statistics(st);
     }
             
     std::ostream& solver::display(std::ostream & out, const equation & eq) const {
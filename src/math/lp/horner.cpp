@@ -67,6 +67,68 @@ bool horner::row_is_interesting(const T& row) const {
     return false;
 }
 
+unsigned horner::bounds_fingerprint(lpvar j, unsigned h) const {
+    lp::constraint_index ci;
+    rational val;
+    bool is_strict;
+    if (c().m_lar_solver.has_lower_bound(j, ci, val, is_strict)) 
+        h = combine_hash(h, combine_hash(val.hash(), is_strict));
+    else
+        h = combine_hash(h, 17);
+    if (c().m_lar_solver.has_upper_bound(j, ci, val, is_strict)) 
+        h = combine_hash(h, combine_hash(val.hash(), is_strict));
+    else
+        h = combine_hash(h, 31);
+    return h;
+}
+
+// Collects the variables and monomials of the row into structure and 
+// returns a fingerprint of the coefficients and the bounds of the variables.
+template <typename T>
+unsigned horner::row_fingerprint(const T& row, unsigned_vector& structure) const {
+    structure.reset();
+    unsigned h = row.size();
+    for (const auto& p : row) {
+        lpvar j = p.var();
+        structure.push_back(j);
+        h = combine_hash(h, p.coeff().hash());
+        h = bounds_fingerprint(j, h);
+        if (!c().is_monic_var(j)) {
+            structure.push_back(0);
+            continue;
+        }
+        auto & m = c().emons()[j];
+        structure.push_back(m.size());
+        for (lpvar k : m.vars()) {
+            structure.push_back(k);
+            h = bounds_fingerprint(k, h);
+        }
+    }
+    return h;
+}
+
+bool horner::row_is_cached(unsigned i, unsigned fingerprint) {
+    if (i >= m_row_cache.size() || c().m_nla_settings.horner_row_cache_skips() == 0)
+        return false;
+    row_entry& e = m_row_cache[i];
+    if (!e.m_valid || e.m_fingerprint != fingerprint || e.m_structure != m_structure)
+        return false;
+    if (++e.m_skips <= c().m_nla_settings.horner_row_cache_skips())
+        return true;
+    e.m_valid = false;
+    c().lp_settings().stats().m_horner_cache_expired++;
+    return false;
+}
+
+void horner::cache_row(unsigned i, unsigned fingerprint) {
+    m_row_cache.reserve(i + 1);
+    row_entry& e = m_row_cache[i];
+    e.m_valid = true;
+    e.m_skips = 0;
+    e.m_fingerprint = fingerprint;
+    e.m_structure = m_structure;
+}
+
 bool horner::lemmas_on_expr(cross_nested& cn, nex_sum* e) {
     TRACE("nla_horner", tout << "e = " << *e << "\n";);
     cn.run(e);
@@ -122,9 +184,20 @@ bool horner::horner_lemmas() {
     bool conflict = false;
     for (unsigned i = 0; i < sz && !conflict; i++) {
         m_row_index = rows[(i + r) % sz];
+        unsigned fingerprint = row_fingerprint(matrix.m_rows[m_row_index], m_structure);
+        if (row_is_cached(m_row_index, fingerprint)) {
+            c().lp_settings().stats().m_horner_cache_hits++;
+            continue;
+        }
+        c().lp_settings().stats().m_horner_cache_misses++;
         if (lemmas_on_row(matrix.m_rows[m_row_index])) {
             c().lp_settings().stats().m_horner_conflicts++;
             conflict = true;
+            if (m_row_index < m_row_cache.size())
+                m_row_cache[m_row_index].m_valid = false;
+        }
+        else {
+            cache_row(m_row_index, fingerprint);
         }
     }
     return conflict;
@@ -30,8 +30,30 @@ class core;
 
 
 class horner : common {
+    /**
+       Rows for which horner did not find a conflict, together with
+       the structure of the row and a fingerprint of the bounds it was checked under.
+       The row is skipped as long as neither its monomials nor the bounds change,
+       for at most horner_row_cache_skips rounds. Then it is checked again, since
+       cross_nested explores random orders and the fingerprint may collide.
+    */
+    struct row_entry {
+        bool            m_valid;
+        unsigned_vector m_structure;
+        unsigned        m_fingerprint;
+        unsigned        m_skips;
+        row_entry(): m_valid(false), m_fingerprint(0), m_skips(0) {}
+    };
     nex_creator::sum_factory  m_row_sum;
     unsigned         m_row_index;                      
+    vector<row_entry>         m_row_cache;
+    unsigned_vector           m_structure;
+
+    template <typename T>
+    unsigned row_fingerprint(const T&, unsigned_vector& structure) const;
+    unsigned bounds_fingerprint(lpvar j, unsigned h) const;
+    bool row_is_cached(unsigned i, unsigned fingerprint);
+    void cache_row(unsigned i, unsigned fingerprint);
 public:
     typedef intervals::interval interv;
     horner(core *core);
@@ -90,6 +90,7 @@ class lar_solver : public column_namer {
     // the set of column indices j such that bounds have changed for j
     u_set                                               m_columns_with_changed_bounds;
     u_set                                               m_rows_with_changed_bounds;
+    unsigned_vector                                     m_propagated_rows;
     u_set                                               m_basic_columns_with_changed_cost;
     // these are basic columns with the value changed, so the the corresponding row in the tableau
     // does not sum to zero anymore
@@ -358,23 +359,39 @@ public:
     template <typename T>
     void propagate_bounds_for_touched_rows(lp_bound_propagator<T> & bp) {
         SASSERT(use_tableau());
+        // analyze the touched rows until the effort limit is reached,
+        // the rest of the rows stay touched and are analyzed by the next call
+        unsigned cells = 0;
+        m_propagated_rows.reset();
         for (unsigned i : m_rows_with_changed_bounds) {
+            if (cells >= settings().max_cells_for_bound_propagation)
+                break;
+            cells += A_r().m_rows[i].size();
+            m_propagated_rows.push_back(i);
             calculate_implied_bounds_for_row(i, bp);
             if (settings().get_cancel_flag())
                 return;
         }
+        settings().stats().m_bound_prop_rows += m_propagated_rows.size();
         // these two loops should be run sequentially
         // since the first loop might change column bounds
         // and add fixed columns this way
         if (settings().cheap_eqs()) {
             bp.clear_for_eq();
-            for (unsigned i : m_rows_with_changed_bounds) {
+            for (unsigned i : m_propagated_rows) {
                 calculate_cheap_eqs_for_row(i, bp);
                 if (settings().get_cancel_flag())
                     return;
             }
         }
-        m_rows_with_changed_bounds.clear();
+        if (m_propagated_rows.size() == m_rows_with_changed_bounds.size()) {
+            m_rows_with_changed_bounds.clear();
+        }
+        else {
+            settings().stats().m_bound_prop_deferred_rows += m_rows_with_changed_bounds.size() - m_propagated_rows.size();
+            for (unsigned i : m_propagated_rows)
+                m_rows_with_changed_bounds.erase(i);
+        }
     }
     template <typename T>
     void calculate_cheap_eqs_for_row(unsigned i, lp_bound_propagator<T> & bp) {
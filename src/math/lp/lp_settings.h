@@ -122,9 +122,14 @@ struct statistics {
     unsigned m_horner_calls;
     unsigned m_horner_conflicts;
     unsigned m_cross_nested_forms;
+    unsigned m_horner_cache_hits;
+    unsigned m_horner_cache_misses;
+    unsigned m_horner_cache_expired;
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
     unsigned m_cheap_eqs;
+    unsigned m_bound_prop_rows;
+    unsigned m_bound_prop_deferred_rows;
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
@@ -142,9 +147,14 @@ struct statistics {
         st.update("arith-horner-calls", m_horner_calls);
         st.update("arith-horner-conflicts", m_horner_conflicts);
         st.update("arith-horner-cross-nested-forms", m_cross_nested_forms);
+        st.update("arith-horner-cache-hits", m_horner_cache_hits);
+        st.update("arith-horner-cache-misses", m_horner_cache_misses);
+        st.update("arith-horner-cache-expired", m_horner_cache_expired);
         st.update("arith-grobner-calls", m_grobner_calls);
         st.update("arith-grobner-conflicts", m_grobner_conflicts);
         st.update("arith-cheap-eqs", m_cheap_eqs);
+        st.update("arith-bound-prop-rows", m_bound_prop_rows);
+        st.update("arith-bound-prop-deferred-rows", m_bound_prop_deferred_rows);
 
     }
 };
@@ -224,6 +234,9 @@ public:
     double           density_threshold;
     bool             use_breakpoints_in_feasibility_search;
     unsigned         max_row_length_for_bound_propagation;
+    // the number of row entries bound propagation analyzes in one call,
+    // rows beyond the limit are kept for the next call
+    unsigned         max_cells_for_bound_propagation;
     bool             backup_costs;
     unsigned         column_number_threshold_for_using_lu_in_lar_solver;
     unsigned         m_int_gomory_cut_period;
@@ -298,6 +311,7 @@ public:
                     density_threshold(0.7),
                     use_breakpoints_in_feasibility_search(false),
                     max_row_length_for_bound_propagation(300),
+                    max_cells_for_bound_propagation(UINT_MAX),
                     backup_costs(true),
                     column_number_threshold_for_using_lu_in_lar_solver(4000),
                     m_int_gomory_cut_period(4),
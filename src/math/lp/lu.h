@@ -147,6 +147,8 @@ public:
     indexed_vector<T>           m_y_copy;
     indexed_vector<unsigned>    m_ii; //to optimize the work with the m_index fields
     unsigned                    m_refactor_counter;
+    unsigned                    m_factorization_size; // the number of non-zeroes in U after the factorization
+    unsigned                    m_fill_in;            // the number of non-zeroes U has gained since then
     // constructor
     // if A is an m by n matrix then basis has length m and values in [0,n); the values are all different
     // they represent the set of m columns
@@ -309,7 +311,9 @@ public:
     void prepare_entering(unsigned entering, indexed_vector<T> & w) {
         init_vector_w(entering, w);
     }
-    bool need_to_refactor() { return m_refactor_counter >= 200; }
+    // refactor after many updates, or when the updates have more than doubled
+    // the non-zeroes of U, so the solves touch too many entries
+    bool need_to_refactor() { return m_refactor_counter >= 200 || m_fill_in > m_factorization_size; }
     
     void adjust_dimension_with_matrix_A() {
         lp_assert(m_A.row_count() >= m_dim);
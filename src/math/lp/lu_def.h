@@ -114,13 +114,16 @@ lu<M>::lu(const M& A,
     m_settings(settings),
     m_failure(false),
     m_row_eta_work_vector(A.row_count()),
-    m_refactor_counter(0) {
+    m_refactor_counter(0),
+    m_factorization_size(0),
+    m_fill_in(0) {
     lp_assert(!(numeric_traits<T>::precise() && settings.use_tableau()));
 #ifdef Z3DEBUG
     debug_test_of_basis(A, basis);
 #endif
     ++m_settings.stats().m_num_factorizations;
     create_initial_factorization();
+    m_factorization_size = m_U.get_number_of_nonzeroes();
 #ifdef Z3DEBUG
     // lp_assert(check_correctness());
 #endif
@@ -138,9 +141,12 @@ lu<M>::lu(const M& A,
     m_settings(settings),
     m_failure(false),
     m_row_eta_work_vector(A.row_count()),
-    m_refactor_counter(0) {
+    m_refactor_counter(0),
+    m_factorization_size(0),
+    m_fill_in(0) {
     lp_assert(A.row_count() == A.column_count());
     create_initial_factorization();
+    m_factorization_size = m_U.get_number_of_nonzeroes();
 #ifdef Z3DEBUG
     lp_assert(is_correct());
 #endif
@@ -923,6 +929,8 @@ void lu<M>::replace_column(T pivot_elem_for_checking, indexed_vector<T> & w, uns
         push_matrix_to_tail(row_eta);
     }
     calculate_Lwave_Pwave_for_bump(replaced_column, lowest_row_of_the_bump);
+    unsigned nz = m_U.get_number_of_nonzeroes();
+    m_fill_in = nz > m_factorization_size ? nz - m_factorization_size : 0;
     // lp_assert(m_U.is_upper_triangular_and_maximums_are_set_correctly_in_rows(m_settings));
     // lp_assert(w.is_OK() && m_row_eta_work_vector.is_OK());
 }
@@ -17,6 +17,8 @@ class nla_settings {
     unsigned m_horner_frequency;
     unsigned m_horner_row_length_limit;
     unsigned m_horner_subs_fixed;
+    // how many rounds a row without horner conflict is skipped
+    unsigned m_horner_row_cache_skips;
     // grobner fields
     bool     m_run_grobner;
     unsigned m_grobner_row_length_limit;
@@ -39,6 +41,7 @@ public:
                      m_horner_frequency(4),
                      m_horner_row_length_limit(10),
                      m_horner_subs_fixed(2),
+                     m_horner_row_cache_skips(8),
                      m_run_grobner(true),
                      m_grobner_row_length_limit(50),
                      m_grobner_subs_fixed(false),
@@ -67,6 +70,8 @@ public:
     unsigned& horner_row_length_limit() { return m_horner_row_length_limit; }    
     unsigned horner_subs_fixed() const { return m_horner_subs_fixed; }
     unsigned& horner_subs_fixed() { return m_horner_subs_fixed; }
+    unsigned horner_row_cache_skips() const { return m_horner_row_cache_skips; }
+    unsigned& horner_row_cache_skips() { return m_horner_row_cache_skips; }
 
     bool run_grobner() const { return m_run_grobner; }
     bool& run_grobner() { return m_run_grobner; }
@@ -67,6 +67,8 @@ public:
     // if the column is not present then m_work_pivot_vector[j] is -1
     vector<int>                       m_work_pivot_vector;
     vector<bool>                      m_processed;
+    // stack of (index, position of the next entry to visit) used by the depth first searches of the hypersparse solves
+    vector<std::pair<unsigned, unsigned>> m_dfs_stack;
     unsigned get_n_of_active_elems() const { return m_n_of_active_elems; }
 
 #ifdef Z3DEBUG
@@ -403,10 +405,13 @@ public:
 
     void check_matrix();
 #endif
+    // a right side is hypersparse if at most a tenth of its entries are non-zero,
+    // then the triangular solves only visit the entries reachable from the non-zeroes
+    bool is_hypersparse(unsigned number_of_non_zeroes) const { return 10 * number_of_non_zeroes <= dimension(); }
     void create_graph_G(const vector<unsigned> & active_rows, vector<unsigned> & sorted_active_rows);
-    void process_column_recursively(unsigned i, vector<unsigned>  & sorted_rows);    
+    void process_column(unsigned i, vector<unsigned>  & sorted_rows);    
     void extend_and_sort_active_rows(const vector<unsigned> & active_rows, vector<unsigned> & sorted_active_rows);
-    void process_index_recursively_for_y_U(unsigned j, vector<unsigned>  & sorted_rows);
+    void process_index_for_y_U(unsigned j, vector<unsigned>  & sorted_rows);
     void resize(unsigned new_dim) {
         unsigned old_dim = dimension();
         lp_assert(new_dim >= old_dim);
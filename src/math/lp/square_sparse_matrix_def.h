@@ -655,42 +655,78 @@ void square_sparse_matrix<T, X>::solve_U_y(vector<L> & y) { // it is a column wi
     // lp_assert(vectors_are_equal(rs, clone_y, dimension()));
 #endif
 }
+// Depth first search from j over the rows of U, using an explicit stack.
+// Indices are appended to sorted_active_rows in post order.
 template <typename T, typename X>
-void square_sparse_matrix<T, X>::process_index_recursively_for_y_U(unsigned j, vector<unsigned> & sorted_active_rows) {
+void square_sparse_matrix<T, X>::process_index_for_y_U(unsigned j, vector<unsigned> & sorted_active_rows) {
     lp_assert(m_processed[j] == false);
-    m_processed[j]=true;
-    auto & row = m_rows[adjust_row(j)];
-    for (auto & c : row) {
-        unsigned i = adjust_column_inverse(c.m_index);
-        if (i == j) continue;
-        if (!m_processed[i]) {
-            process_index_recursively_for_y_U(i, sorted_active_rows);
+    lp_assert(m_dfs_stack.empty());
+    m_processed[j] = true;
+    m_dfs_stack.push_back(std::make_pair(j, 0u));
+    while (!m_dfs_stack.empty()) {
+        unsigned k = m_dfs_stack.back().first;
+        auto & row = m_rows[adjust_row(k)];
+        unsigned pos = m_dfs_stack.back().second;
+        for (; pos < row.size(); pos++) {
+            unsigned i = adjust_column_inverse(row[pos].m_index);
+            if (i != k && !m_processed[i]) 
+                break;
+        }
+        if (pos < row.size()) {
+            unsigned i = adjust_column_inverse(row[pos].m_index);
+            m_dfs_stack.back().second = pos + 1;
+            m_processed[i] = true;
+            m_dfs_stack.push_back(std::make_pair(i, 0u));
+        }
+        else {
+            sorted_active_rows.push_back(k);
+            m_dfs_stack.pop_back();
         }
     }
-    sorted_active_rows.push_back(j);
 }
 
+// Depth first search from j over the columns of U, using an explicit stack.
+// Indices are appended to sorted_active_rows in post order.
 template <typename T, typename X>
-void square_sparse_matrix<T, X>::process_column_recursively(unsigned j, vector<unsigned> & sorted_active_rows) {
+void square_sparse_matrix<T, X>::process_column(unsigned j, vector<unsigned> & sorted_active_rows) {
     lp_assert(m_processed[j] == false);
-    auto & mc = m_columns[adjust_column(j)].m_values;
-    for (auto & iv : mc) {
-        unsigned i = adjust_row_inverse(iv.m_index);
-        if (i == j) continue;
-        if (!m_processed[i]) {
-            process_column_recursively(i, sorted_active_rows);
+    lp_assert(m_dfs_stack.empty());
+    m_processed[j] = true;
+    m_dfs_stack.push_back(std::make_pair(j, 0u));
+    while (!m_dfs_stack.empty()) {
+        unsigned k = m_dfs_stack.back().first;
+        auto & mc = m_columns[adjust_column(k)].m_values;
+        unsigned pos = m_dfs_stack.back().second;
+        for (; pos < mc.size(); pos++) {
+            unsigned i = adjust_row_inverse(mc[pos].m_index);
+            if (i != k && !m_processed[i]) 
+                break;
+        }
+        if (pos < mc.size()) {
+            unsigned i = adjust_row_inverse(mc[pos].m_index);
+            m_dfs_stack.back().second = pos + 1;
+            m_processed[i] = true;
+            m_dfs_stack.push_back(std::make_pair(i, 0u));
+        }
+        else {
+            sorted_active_rows.push_back(k);
+            m_dfs_stack.pop_back();
         }
     }
-    m_processed[j]=true;
-    sorted_active_rows.push_back(j);
 }
 
 
 template <typename T, typename X>
 void square_sparse_matrix<T, X>::create_graph_G(const vector<unsigned> & index_or_right_side, vector<unsigned> & sorted_active_rows) {
+    if (!is_hypersparse(index_or_right_side.size())) {
+        // the solution is not sparse, the depth first search does not pay off
+        for (unsigned i = 0; i < dimension(); i++)
+            sorted_active_rows.push_back(i);
+        return;
+    }
     for (auto i : index_or_right_side) {
         if (m_processed[i]) continue;
-        process_column_recursively(i, sorted_active_rows);
+        process_column(i, sorted_active_rows);
     }
 
     for (auto i : sorted_active_rows) {
@@ -701,9 +737,14 @@ void square_sparse_matrix<T, X>::create_graph_G(const vector<unsigned> & index_o
 
 template <typename T, typename X>
 void square_sparse_matrix<T, X>::extend_and_sort_active_rows(const vector<unsigned> & index_or_right_side, vector<unsigned> & sorted_active_rows) {
+    if (!is_hypersparse(index_or_right_side.size())) {
+        for (unsigned i = dimension(); i-- > 0; )
+            sorted_active_rows.push_back(i);
+        return;
+    }
     for (auto i : index_or_right_side) {
         if (m_processed[i]) continue;
-        process_index_recursively_for_y_U(i, sorted_active_rows);
+        process_index_for_y_U(i, sorted_active_rows);
     }
 
     for (auto i : sorted_active_rows) {
@@ -158,7 +158,7 @@ namespace sat {
         ++m_calls;
         if (m_calls <= m_asymm_branch_delay)
             return;
-        if (!m_asymm_branch && !m_asymm_branch_all && !m_asymm_branch_sampled)
+        if (!m_asymm_branch && !m_asymm_branch_all && !m_asymm_branch_sampled && !m_vivify)
             return;
         s.propagate(false); // must propagate, since it uses s.push()
         if (s.m_inconsistent)
@@ -167,6 +167,15 @@ namespace sat {
             m_counter /= 100;
             return;
         }
+        // vivification is charged to the budget of asymmetric branching.
+        int64_t vivify_cost = 0;
+        if (m_vivify && s.m_stats.m_conflict >= m_vivify_next) {
+            vivify_cost = vivify();
+            if (s.m_inconsistent)
+                return;
+        }
+        if (!m_asymm_branch && !m_asymm_branch_all && !m_asymm_branch_sampled)
+            return;
         CASSERT("asymm_branch", s.check_invariant());
         TRACE("asymm_branch_detail", s.display(tout););
         report rpt(*this);
@@ -188,7 +197,8 @@ namespace sat {
                 if (process(big, false)) change = true;
             }
             if (m_asymm_branch) {
-                m_counter  = 0; 
+                m_counter  = -vivify_cost; 
+                vivify_cost = 0;
                 if (process(false)) change = true;
                 m_counter = -m_counter;
             }
@@ -330,6 +340,7 @@ namespace sat {
                     break;
                 }
             }
+            count_elim_literals(c, j);
             return re_attach(scoped_d, c, j);
         }
         else {
@@ -387,17 +398,21 @@ namespace sat {
             }
         }
         new_sz = j;                
+        count_elim_literals(c, new_sz);
         return re_attach(scoped_d, c, new_sz);
     }
 
-    bool asymm_branch::re_attach(scoped_detach& scoped_d, clause& c, unsigned new_sz) {
-        VERIFY(s.m_trail.size() == s.m_qhead);
+    void asymm_branch::count_elim_literals(clause const& c, unsigned new_sz) {
         unsigned old_sz = c.size();
         m_elim_literals += old_sz - new_sz;
         if (c.is_learned()) {
             m_elim_learned_literals += old_sz - new_sz; 
         }
+    }
 
+    bool asymm_branch::re_attach(scoped_detach& scoped_d, clause& c, unsigned new_sz) {
+        VERIFY(s.m_trail.size() == s.m_qhead);
+        unsigned old_sz = c.size();
         switch (new_sz) {
         case 0:
             s.set_conflict();
@@ -421,6 +436,117 @@ namespace sat {
         }
     }
 
+    struct asymm_branch::compare_occ {
+        unsigned_vector const& m_occ;
+        compare_occ(unsigned_vector const& occ): m_occ(occ) {}
+        bool operator()(literal u, literal v) const {
+            return m_occ[u.index()] > m_occ[v.index()];
+        }
+    };
+
+    bool asymm_branch::is_vivify_candidate(clause const& c) const {
+        return c.is_learned() && !c.frozen() && !c.was_removed() && c.glue() <= m_vivify_glue;
+    }
+
+    /**
+       \brief vivify learned clauses whose glue is at most m_vivify_glue.
+       Literals are sorted by their number of occurrences in the candidate 
+       clauses, so that the most frequent literals are propagated first.
+       Returns the number of literals visited.
+    */
+    int64_t asymm_branch::vivify() {
+        m_vivify_next = s.m_stats.m_conflict + m_vivify_conflicts;
+        m_occ.reset();
+        m_occ.resize(2 * s.num_vars(), 0);
+        for (clause* c : s.m_learned) 
+            if (is_vivify_candidate(*c))
+                for (literal l : *c)
+                    m_occ[l.index()]++;
+
+        unsigned vivified = m_vivified, elim = m_vivify_literals;
+        int64_t budget = m_asymm_branch_limit;
+        bool_vector saved_phase(s.m_phase);
+        flet<bool> _is_probing(s.m_is_probing, true);
+        clause_vector& clauses = s.m_learned;
+        clause_vector::iterator it  = clauses.begin();
+        clause_vector::iterator it2 = it;
+        clause_vector::iterator end = clauses.end();
+        try {
+            for (; it != end; ++it) {
+                clause & c = *(*it);
+                if (budget > 0 && !s.inconsistent() && is_vivify_candidate(c)) {
+                    s.checkpoint();
+                    if (!vivify(c, budget))
+                        continue; // clause was removed
+                }
+                *it2 = *it;
+                ++it2;
+            }
+            clauses.set_end(it2);
+        }
+        catch (solver_exception &) {
+            for (; it != end; ++it, ++it2) {
+                *it2 = *it;
+            }
+            clauses.set_end(it2);
+            s.m_phase = saved_phase;
+            throw;
+        }
+        s.m_phase = saved_phase;
+        IF_VERBOSE(2, verbose_stream() << " (sat-vivify :clauses " << (m_vivified - vivified) 
+                   << " :elim-literals " << (m_vivify_literals - elim) << ")\n";);
+        return m_asymm_branch_limit - budget;
+    }
+
+    /**
+       \brief assign the negations of the literals of c in order.
+       A literal that becomes false is redundant. If a literal becomes true, 
+       or propagation produces a conflict, the remaining literals are redundant.
+    */
+    bool asymm_branch::vivify(clause & c, int64_t& budget) {
+        SASSERT(s.scope_lvl() == 0);
+        SASSERT(!s.inconsistent());
+        for (literal l : c) {
+            if (s.value(l) == l_true) {
+                s.detach_clause(c);
+                s.del_clause(c);
+                return false;
+            }
+        }
+        scoped_detach scoped_d(s, c);
+        unsigned sz = c.size();
+        std::sort(c.begin(), c.end(), compare_occ(m_occ));
+        unsigned trail_sz = s.m_trail.size();
+        unsigned j = 0;
+        bool done = false;
+        s.push();
+        for (unsigned i = 0; !done && i < sz; ++i) {
+            literal l = c[i];
+            switch (s.value(l)) {
+            case l_true:
+                std::swap(c[i], c[j++]);
+                done = true;
+                break;
+            case l_false:
+                break;
+            case l_undef:
+                std::swap(c[i], c[j++]);
+                s.assign_scoped(~l);
+                s.propagate_core(false);
+                done = s.inconsistent();
+                break;
+            }
+        }
+        budget -= sz + s.m_trail.size() - trail_sz;
+        s.pop(1);
+        if (j == sz)
+            return true;
+        TRACE("asymm_branch", tout << "vivified: " << c << " to size " << j << "\n";);
+        m_vivified++;
+        m_vivify_literals += sz - j;
+        return re_attach(scoped_d, c, j);
+    }
+
     bool asymm_branch::process_sampled(big& big, clause & c) {
         scoped_detach scoped_d(s, c);
         sort(big, c);
@@ -478,6 +604,9 @@ namespace sat {
         m_asymm_branch_sampled = p.asymm_branch_sampled();
         m_asymm_branch_limit   = p.asymm_branch_limit();
         m_asymm_branch_all     = p.asymm_branch_all();
+        m_vivify               = p.asymm_branch_vivify();
+        m_vivify_glue          = p.asymm_branch_vivify_glue();
+        m_vivify_conflicts     = p.asymm_branch_vivify_conflicts();
         if (m_asymm_branch_limit > UINT_MAX)
             m_asymm_branch_limit = UINT_MAX;
     }
@@ -489,12 +618,16 @@ namespace sat {
     void asymm_branch::collect_statistics(statistics & st) const {
         st.update("sat elim literals", m_elim_literals);
         st.update("sat tr", m_tr);
+        st.update("sat vivified clauses", m_vivified);
+        st.update("sat vivify literals", m_vivify_literals);
     }
 
     void asymm_branch::reset_statistics() {
         m_elim_literals = 0;
         m_elim_learned_literals = 0;
         m_tr = 0;
+        m_vivified = 0;
+        m_vivify_literals = 0;
     }
 
 };
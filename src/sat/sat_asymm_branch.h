@@ -44,18 +44,26 @@ namespace sat {
         bool       m_asymm_branch_sampled;
         bool       m_asymm_branch_all;
         int64_t    m_asymm_branch_limit;
+        bool       m_vivify;
+        unsigned   m_vivify_glue;
+        unsigned   m_vivify_conflicts;
+        unsigned   m_vivify_next { 0 };
 
         // stats
         unsigned   m_elim_literals;
         unsigned   m_elim_learned_literals;
         unsigned   m_tr;
+        unsigned   m_vivified;
+        unsigned   m_vivify_literals;
 
         literal_vector m_pos, m_neg; // literals (complements of literals) in clauses sorted by discovery time (m_left in BIG).
         svector<std::pair<literal, unsigned>> m_pos1, m_neg1;
         literal_vector m_to_delete;
         literal_vector m_tmp;
+        unsigned_vector m_occ;   // occurrences of literals in vivification candidates
        
         struct compare_left;
+        struct compare_occ;
 
         bool is_touched(bool_var v) const;
 
@@ -70,6 +78,8 @@ namespace sat {
 
         bool re_attach(scoped_detach& scoped_d, clause& c, unsigned new_sz);
 
+        void count_elim_literals(clause const& c, unsigned new_sz);
+
         bool process(bool learned);
 
         bool process(big& big, bool learned);
@@ -90,6 +100,12 @@ namespace sat {
 
         bool propagate_literal(clause const& c, literal l);
 
+        bool is_vivify_candidate(clause const& c) const;
+
+        int64_t vivify();
+
+        bool vivify(clause& c, int64_t& budget);
+
     public:
         asymm_branch(solver & s, params_ref const & p);
 
@@ -77,6 +77,7 @@ namespace sat {
         m_propagate_prefetch = p.propagate_prefetch();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
+        m_inprocess_backoff = p.inprocess_backoff();
 
         m_random_freq     = p.random_freq();
         m_random_seed     = p.random_seed();
@@ -185,6 +186,7 @@ namespace sat {
 
         m_backtrack_scopes = p.backtrack_scopes();
         m_backtrack_init_conflicts = p.backtrack_conflicts();
+        m_backtrack_reuse_trail = p.backtrack_reuse_trail();
 
         m_minimize_lemmas = p.minimize_lemmas();
         m_core_minimize   = p.core_minimize();
@@ -104,6 +104,7 @@ namespace sat {
         double             m_slow_glue_avg;
         unsigned           m_inprocess_max;
         symbol             m_inprocess_out;
+        bool               m_inprocess_backoff;
         double             m_random_freq;
         unsigned           m_random_seed;
         unsigned           m_burst_search;
@@ -166,6 +167,7 @@ namespace sat {
         // backtracking
         unsigned           m_backtrack_scopes;
         unsigned           m_backtrack_init_conflicts;
+        bool               m_backtrack_reuse_trail;
 
         bool               m_minimize_lemmas;
         bool               m_dyn_sub_res;
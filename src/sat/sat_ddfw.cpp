@@ -200,6 +200,9 @@ namespace sat {
         m_last_flips = 0;
         m_shifts = 0;
         m_stopwatch.start();
+        m_flip_watch.stop();
+        m_flip_watch.reset();
+        m_flip_watch.start();
     }
 
     void ddfw::reinit(solver& s) {
@@ -410,6 +413,11 @@ namespace sat {
                 m_model[i] = to_lbool(value(i));
             }
         }
+        if (m_unsat.size() < m_min_sz || m_best_values.size() != num_vars()) {
+            m_best_values.reset();
+            for (unsigned v = 0; v < num_vars(); ++v) 
+                m_best_values.push_back(value(v));
+        }
         if (m_unsat.size() < m_min_sz) {
             m_models.reset();
             // skip saving the first model.
@@ -529,6 +537,17 @@ namespace sat {
         return out;
     }
 
+    void ddfw::collect_statistics(statistics& st) const {
+        st.update("ddfw flips", static_cast<unsigned>(m_flips));
+        st.update("ddfw restarts", m_restart_count);
+        st.update("ddfw reinits", m_reinit_count);
+        st.update("ddfw shifts", static_cast<unsigned>(m_shifts));
+        st.update("ddfw parallel syncs", m_parsync_count);
+        double sec = m_flip_watch.get_current_seconds();
+        if (sec > 0) 
+            st.update("ddfw kflips/sec", m_flips / (1000.0 * sec));
+    }
+
     void ddfw::invariant() {
         // every variable in unsat vars is in a false clause.
         for (bool_var v : m_unsat_vars) {
@@ -82,6 +82,7 @@ namespace sat {
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
         model                m_model;       // var -> best assignment
+        bool_vector          m_best_values; // var -> assignment with fewest unsatisfied clauses
         
         vector<unsigned_vector> m_use_list;
         unsigned_vector  m_flat_use_list;
@@ -97,6 +98,7 @@ namespace sat {
         unsigned         m_min_sz{ 0 };
         hashtable<unsigned, unsigned_hash, default_eq<unsigned>> m_models;
         stopwatch        m_stopwatch;
+        stopwatch        m_flip_watch;      // time since init, for the flip rate statistic
 
         parallel*        m_par;
 
@@ -217,9 +219,13 @@ namespace sat {
         unsigned num_non_binary_clauses() const override { return m_num_non_binary_clauses; }
         void reinit(solver& s) override;
 
-        void collect_statistics(statistics& st) const override {} 
+        void collect_statistics(statistics& st) const override;
 
         double get_priority(bool_var v) const override { return m_probs[v]; }
+
+        unsigned get_best_num_unsat() const override { return m_best_values.empty() ? UINT_MAX : m_min_sz; }
+
+        bool get_best_value(bool_var v) const override { return v < m_best_values.size() && m_best_values[v]; }
     };
 }
 
@@ -92,7 +92,7 @@ namespace sat{
         model_converter::entry & mc_entry = s.m_mc.mk(model_converter::ELIM_VAR, v);
         simp.save_clauses(mc_entry, simp.m_pos_cls);
         simp.save_clauses(mc_entry, simp.m_neg_cls);
-        s.m_eliminated[v] = true;
+        s.set_eliminated(v, true);
         ++s.m_stats.m_elim_var_bdd;
         simp.remove_bin_clauses(pos_l);
         simp.remove_bin_clauses(neg_l);
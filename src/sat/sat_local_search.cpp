@@ -71,13 +71,12 @@ namespace sat {
             coeff_vector& truep = m_vars[v].m_watch[is_true];
             for (auto const& coeff : truep) {
                 unsigned c = coeff.m_constraint_id;
-                constraint& cn = m_constraints[c];
-                cn.m_slack -= coeff.m_coeff;
+                m_slack[c] -= coeff.m_coeff;
             }            
         }
         for (unsigned c = 0; c < num_constraints(); ++c) {
             // violate the at-most-k constraint
-            if (m_constraints[c].m_slack < 0)
+            if (m_slack[c] < 0)
                 unsat(c);
         }
     }
@@ -89,21 +88,21 @@ namespace sat {
             coeff_vector& truep = m_vars[v].m_watch[is_true];
             coeff_vector& falsep = m_vars[v].m_watch[!is_true];
             for (auto const& coeff : falsep) {
-                constraint& c = m_constraints[coeff.m_constraint_id];
+                int64_t slack = m_slack[coeff.m_constraint_id];
                 // will --slack
-                if (c.m_slack <= 0) {
+                if (slack <= 0) {
                     dec_slack_score(v);
-                    if (c.m_slack == 0)
+                    if (slack == 0)
                         dec_score(v);
                 }
             }
             for (auto const& coeff : truep) {
-                constraint& c = m_constraints[coeff.m_constraint_id];
+                int64_t slack = m_slack[coeff.m_constraint_id];
                 // will --true_terms_count[c]
                 // will ++slack
-                if (c.m_slack <= -1) {
+                if (slack <= -1) {
                     inc_slack_score(v);
-                    if (c.m_slack == -1)
+                    if (slack == -1)
                         inc_score(v);
                 }
             }
@@ -138,8 +137,8 @@ namespace sat {
             m_noise += (10000 - m_noise) * m_noise_delta;
         }
 
-        for (constraint & c : m_constraints) {
-            c.m_slack = c.m_k;
+        for (constraint const& c : m_constraints) {
+            m_slack[c.m_id] = c.m_k;
         }
         
         // init unsat stack
@@ -268,7 +267,7 @@ namespace sat {
     }
 
     void local_search::verify_slack(constraint const& c) const {
-        VERIFY(constraint_value(c) + c.m_slack == c.m_k);
+        VERIFY(constraint_value(c) + m_slack[c.m_id] == c.m_k);
     }
 
     void local_search::verify_slack() const {
@@ -307,6 +306,7 @@ namespace sat {
         }
         unsigned id = m_constraints.size();
         m_constraints.push_back(constraint(k, id));
+        m_slack.push_back(0);
         for (unsigned i = 0; i < sz; ++i) {
             m_vars.reserve(c[i].var() + 1);
             literal t(~c[i]);            
@@ -325,6 +325,7 @@ namespace sat {
         m_is_pb = true;
         unsigned id = m_constraints.size();
         m_constraints.push_back(constraint(k, id));
+        m_slack.push_back(0);
         for (unsigned i = 0; i < sz; ++i) {
             m_vars.reserve(c[i].var() + 1);            
             literal t(c[i]);            
@@ -373,6 +374,7 @@ namespace sat {
         m_is_pb = false;
         m_vars.reset();
         m_constraints.reset();
+        m_slack.reset();
         m_units.reset();
         m_unsat_stack.reset();
         m_vars.reserve(s.num_vars());
@@ -706,21 +708,21 @@ namespace sat {
 
         for (auto const& pbc : truep) {
             unsigned ci = pbc.m_constraint_id;
-            constraint& c = m_constraints[ci];
-            auto old_slack = c.m_slack;
-            c.m_slack -= pbc.m_coeff;
-            DEBUG_CODE(verify_slack(c););
-            if (c.m_slack < 0 && old_slack >= 0) { // from non-negative to negative: sat -> unsat
+            int64_t& slack = m_slack[ci];
+            int64_t old_slack = slack;
+            slack -= pbc.m_coeff;
+            DEBUG_CODE(verify_slack(m_constraints[ci]););
+            if (slack < 0 && old_slack >= 0) { // from non-negative to negative: sat -> unsat
                 unsat(ci);
             }
         }
         for (auto const& pbc : falsep) {
             unsigned ci = pbc.m_constraint_id;
-            constraint& c = m_constraints[ci];
-            auto old_slack = c.m_slack;
-            c.m_slack += pbc.m_coeff;
-            DEBUG_CODE(verify_slack(c););
-            if (c.m_slack >= 0 && old_slack < 0) { // from negative to non-negative: unsat -> sat
+            int64_t& slack = m_slack[ci];
+            int64_t old_slack = slack;
+            slack += pbc.m_coeff;
+            DEBUG_CODE(verify_slack(m_constraints[ci]););
+            if (slack >= 0 && old_slack < 0) { // from negative to non-negative: unsat -> sat
                 sat(ci);
             }
         }
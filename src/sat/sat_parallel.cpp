@@ -90,7 +90,7 @@ namespace sat {
         return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_phases_num_unsat(UINT_MAX), m_phases_version(0), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -221,6 +221,13 @@ namespace sat {
         for (bool_var v = 0; v < m_priorities.size(); ++v) {
             s.update_activity(v, m_priorities[v]);
         }
+        m_phases_consumed.reserve(s.m_par_id + 1, 0);
+        if (m_phases_consumed[s.m_par_id] != m_phases_version) {
+            m_phases_consumed[s.m_par_id] = m_phases_version;
+            for (bool_var v = 0; v < m_phases.size() && v < s.num_vars(); ++v) {
+                s.m_phase[v] = m_phases[v];
+            }
+        }
         return true;
     }
 
@@ -239,6 +246,15 @@ namespace sat {
         for (bool_var v = 0; m_solver_copy && v < m_solver_copy->num_vars(); ++v) {
             m_priorities.push_back(s.get_priority(v));
         }
+        if (m_solver_copy && s.get_best_num_unsat() < m_phases_num_unsat) {
+            m_phases_num_unsat = s.get_best_num_unsat();
+            ++m_phases_version;
+            m_phases.reset();
+            for (bool_var v = 0; v < m_solver_copy->num_vars(); ++v) {
+                m_phases.push_back(s.get_best_value(v));
+            }
+            IF_VERBOSE(2, verbose_stream() << "(sat-parallel phases :unsat " << m_phases_num_unsat << ")\n";);
+        }
     }
 
     bool parallel::_from_solver(i_local_search& s) {
@@ -247,6 +263,9 @@ namespace sat {
         if (m_solver_copy) {
             copied = true;
             s.reinit(*m_solver_copy.get());
+            // the walker now searches the current clauses, so counts of
+            // unsatisfied clauses from earlier rounds are not comparable.
+            m_phases_num_unsat = UINT_MAX;
         }
         return copied;
     }
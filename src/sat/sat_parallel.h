@@ -68,6 +68,11 @@ namespace sat {
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
+        // best assignment found by local search, exported as phases to CDCL solvers.
+        bool_vector        m_phases;
+        unsigned           m_phases_num_unsat;
+        unsigned           m_phases_version;
+        unsigned_vector    m_phases_consumed; // par id -> version of phases last imported
 
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
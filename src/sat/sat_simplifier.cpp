@@ -114,6 +114,10 @@ namespace sat {
     bool simplifier::elim_vars_bdd_enabled() const { 
         return !m_incremental_mode && !s.tracking_assumptions() && m_elim_vars_bdd && m_num_calls >= m_elim_vars_bdd_delay && single_threaded(); 
     }
+    bool simplifier::bva_enabled() const {
+        return m_bva && !m_incremental_mode && !s.m_ext && s.num_user_scopes() == 0 && single_threaded();
+    }
+
     bool simplifier::elim_vars_enabled() const { 
         return !m_incremental_mode && !s.tracking_assumptions() && m_elim_vars && single_threaded(); 
     }    
@@ -190,6 +194,10 @@ namespace sat {
 
     void simplifier::operator()(bool learned) {
 
+        if (s.inconsistent())
+            return;
+        if (!learned)
+            bva();
         if (s.inconsistent())
             return;
         if (!m_subsumption && !bce_enabled() && !bca_enabled() && !elim_vars_enabled())
@@ -1900,6 +1908,63 @@ namespace sat {
         }
     }
 
+    /**
+       \brief Detect a definition l <-> AND(~c1, .., ~ck): a clause (l | c1 | .. | ck) in l_cls 
+       together with binary clauses (~l | ~ci) in nl_cls. The clauses of the definition are 
+       marked in l_gate and nl_gate.
+    */
+    bool simplifier::find_and_gate(literal l, clause_wrapper_vector const& l_cls, clause_wrapper_vector const& nl_cls, bool_vector& l_gate, bool_vector& nl_gate) {
+        for (clause_wrapper const& c : nl_cls) 
+            if (c.is_binary())
+                mark_visited(c[0] == ~l ? c[1] : c[0]);
+        unsigned idx = l_cls.size();
+        for (unsigned i = 0; i < l_cls.size() && idx == l_cls.size(); ++i) {
+            clause_wrapper const& c = l_cls[i];
+            bool is_gate = true;
+            for (unsigned j = 0; is_gate && j < c.size(); ++j) 
+                is_gate = c[j] == l || is_marked(~c[j]);
+            if (is_gate) 
+                idx = i;
+            m_elim_counter -= c.size();
+        }
+        for (clause_wrapper const& c : nl_cls) 
+            if (c.is_binary())
+                unmark_visited(c[0] == ~l ? c[1] : c[0]);
+        if (idx == l_cls.size())
+            return false;
+
+        clause_wrapper const& g = l_cls[idx];
+        l_gate[idx] = true;
+        for (literal lit : g)
+            if (lit != l)
+                mark_visited(~lit);
+        for (unsigned i = 0; i < nl_cls.size(); ++i) {
+            clause_wrapper const& c = nl_cls[i];
+            if (c.is_binary() && is_marked(c[0] == ~l ? c[1] : c[0]))
+                nl_gate[i] = true;
+        }
+        for (literal lit : g)
+            if (lit != l)
+                unmark_visited(~lit);
+        TRACE("sat_simplifier", tout << "gate " << g << " for " << l << "\n";);
+        return true;
+    }
+
+    /**
+       \brief Resolvents of two gate clauses are tautologies and resolvents of two 
+       non-gate clauses are implied by the remaining resolvents, so when the eliminated 
+       variable is defined by a gate only gate and non-gate clauses are resolved.
+    */
+    bool simplifier::find_gate(literal pos_l) {
+        m_pos_gate.reset();
+        m_neg_gate.reset();
+        m_pos_gate.resize(m_pos_cls.size(), false);
+        m_neg_gate.resize(m_neg_cls.size(), false);
+        return 
+            find_and_gate(pos_l, m_pos_cls, m_neg_cls, m_pos_gate, m_neg_gate) ||
+            find_and_gate(~pos_l, m_neg_cls, m_pos_cls, m_neg_gate, m_pos_gate);
+    }
+
     bool simplifier::try_eliminate(bool_var v) {
         if (value(v) != l_undef)
             return false;
@@ -1945,12 +2010,17 @@ namespace sat {
         m_neg_cls.reset();
         collect_clauses(pos_l, m_pos_cls);
         collect_clauses(neg_l, m_neg_cls);
+        bool has_gate = m_elim_vars_gates && find_gate(pos_l);
 
         TRACE("sat_simplifier", tout << "collecting number of after_clauses\n";);
         unsigned before_clauses = num_pos + num_neg;
         unsigned after_clauses  = 0;
-        for (clause_wrapper& c1 : m_pos_cls) {
-            for (clause_wrapper& c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                if (has_gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
+                clause_wrapper const& c1 = m_pos_cls[i];
+                clause_wrapper const& c2 = m_neg_cls[j];
                 m_new_cls.reset();
                 if (resolve(c1, c2, pos_l, m_new_cls)) {
                     TRACE("sat_simplifier", tout << c1 << "\n" << c2 << "\n-->\n";
@@ -1970,6 +2040,8 @@ namespace sat {
 
         // eliminate variable
         ++s.m_stats.m_elim_var_res;
+        if (has_gate)
+            ++m_num_elim_gates;
         VERIFY(!is_external(v));
         model_converter::entry & mc_entry = s.m_mc.mk(model_converter::ELIM_VAR, v);
         save_clauses(mc_entry, m_pos_cls);
@@ -1977,8 +2049,12 @@ namespace sat {
         s.set_eliminated(v, true);
         m_elim_counter -= num_pos * num_neg + before_lits;
 
-        for (auto & c1 : m_pos_cls) {
-            for (auto & c2 : m_neg_cls) {
+        for (unsigned i = 0; i < m_pos_cls.size(); ++i) {
+            for (unsigned j = 0; j < m_neg_cls.size(); ++j) {
+                if (has_gate && m_pos_gate[i] == m_neg_gate[j])
+                    continue;
+                clause_wrapper const& c1 = m_pos_cls[i];
+                clause_wrapper const& c2 = m_neg_cls[j];
                 m_new_cls.reset();
                 if (!resolve(c1, c2, pos_l, m_new_cls))
                     continue;                
@@ -2075,6 +2151,140 @@ namespace sat {
         m_new_cls.finalize();
     }
 
+    /**
+       \brief Collect the literals a of non-learned binary clauses (l | a).
+    */
+    void simplifier::bva_partners(literal l, literal_vector& partners) {
+        partners.reset();
+        for (watched const& w : get_wlist(~l)) {
+            if (!w.is_binary_non_learned_clause())
+                continue;
+            literal a = w.get_literal();
+            if (m_bva_mark[a.index()] || value(a) != l_undef)
+                continue;
+            m_bva_mark[a.index()] = true;
+            partners.push_back(a);
+        }
+        for (literal a : partners)
+            m_bva_mark[a.index()] = false;
+    }
+
+    /**
+       \brief Bounded variable addition restricted to binary clauses.
+       A set of literals L and a set of partners A such that (l | a) is a clause 
+       for every l in L and a in A forms a biclique. Its |L|*|A| binary clauses are 
+       replaced by (l | ~x) and (a | x) for a fresh variable x. The clauses removed 
+       are resolvents on x, and x can be set to the value of AND(L), so the 
+       transformation preserves satisfiability. Pairwise at-most-one encodings 
+       shrink from quadratic to linear size this way.
+    */
+    void simplifier::bva() {
+        if (!bva_enabled())
+            return;
+        stopwatch sw;
+        sw.start();
+        unsigned num_vars0 = m_num_bva_vars, num_bins0 = m_num_bva_bins;
+        int64_t counter = m_bva_limit;
+        unsigned num_lits = 2 * s.num_vars();
+        m_bva_count.reset();
+        m_bva_count.resize(num_lits, 0);
+        m_bva_mark.reset();
+        m_bva_mark.resize(num_lits, false);
+        for (unsigned idx = 0; idx < num_lits && counter > 0 && !s.inconsistent(); ++idx) {
+            literal l = to_literal(idx);
+            if (was_eliminated(l.var()) || value(l) != l_undef)
+                continue;
+            checkpoint();
+            m_bva_lits.reset();
+            m_bva_lits.push_back(l);
+            bva_partners(l, m_bva_partners);
+            if (m_bva_partners.size() < 2)
+                continue;
+            m_bva_mark[l.index()] = true;
+            while (true) {
+                // count the number of partners shared with each candidate literal
+                m_bva_touched.reset();
+                for (literal a : m_bva_partners) {
+                    for (watched const& w : get_wlist(~a)) {
+                        --counter;
+                        if (!w.is_binary_non_learned_clause())
+                            continue;
+                        literal lp = w.get_literal();
+                        if (m_bva_mark[lp.index()] || value(lp) != l_undef)
+                            continue;
+                        if (m_bva_count[lp.index()]++ == 0)
+                            m_bva_touched.push_back(lp);
+                    }
+                }
+                literal best = null_literal;
+                unsigned best_count = 1;
+                for (literal lp : m_bva_touched) {
+                    if (m_bva_count[lp.index()] > best_count) {
+                        best = lp;
+                        best_count = m_bva_count[lp.index()];
+                    }
+                    m_bva_count[lp.index()] = 0;
+                }
+                if (best == null_literal)
+                    break;
+                // restrict partners to those shared with best
+                bva_partners(best, m_bva_tmp);
+                for (literal a : m_bva_tmp)
+                    m_bva_mark[a.index()] = true;
+                unsigned j = 0;
+                for (literal a : m_bva_partners)
+                    if (m_bva_mark[a.index()])
+                        ++j;
+                unsigned nl = m_bva_lits.size(), np = m_bva_partners.size();
+                int old_red = static_cast<int>(nl * np) - static_cast<int>(nl + np);
+                int new_red = static_cast<int>((nl + 1) * j) - static_cast<int>(nl + 1 + j);
+                if (new_red > old_red) {
+                    j = 0;
+                    for (literal a : m_bva_partners)
+                        if (m_bva_mark[a.index()])
+                            m_bva_partners[j++] = a;
+                    m_bva_partners.shrink(j);
+                }
+                for (literal a : m_bva_tmp)
+                    m_bva_mark[a.index()] = false;
+                if (new_red <= old_red)
+                    break;
+                m_bva_lits.push_back(best);
+                m_bva_mark[best.index()] = true;
+            }
+            for (literal lp : m_bva_lits)
+                m_bva_mark[lp.index()] = false;
+
+            unsigned nl = m_bva_lits.size(), np = m_bva_partners.size();
+            if (nl * np <= nl + np)
+                continue;
+            bool_var x = s.mk_var(false, true);
+            m_bva_count.resize(2 * s.num_vars(), 0);
+            m_bva_mark.resize(2 * s.num_vars(), false);
+            TRACE("sat_simplifier", tout << "bva " << x << " lits: " << m_bva_lits << " partners: " << m_bva_partners << "\n";);
+            // the new clauses are RAT on the fresh literal, which comes first in the DRAT proof.
+            for (literal lp : m_bva_lits) {
+                if (s.m_config.m_drat) s.m_drat.add(literal(x, true), lp, status::redundant());
+                add_non_learned_binary_clause(literal(x, true), lp);
+            }
+            for (literal a : m_bva_partners) {
+                if (s.m_config.m_drat) s.m_drat.add(literal(x, false), a, status::redundant());
+                add_non_learned_binary_clause(literal(x, false), a);
+            }
+            for (literal lp : m_bva_lits)
+                for (literal a : m_bva_partners)
+                    s.detach_bin_clause(lp, a, false);
+            counter -= nl * np;
+            m_num_bva_vars++;
+            m_num_bva_bins += nl * np - nl - np;
+        }
+        sw.stop();
+        IF_VERBOSE(SAT_VB_LVL, if (m_num_bva_vars > num_vars0)
+                   verbose_stream() << " (sat-bva :vars " << (m_num_bva_vars - num_vars0) 
+                   << " :removed-binaries " << (m_num_bva_bins - num_bins0) 
+                   << " :time " << std::fixed << std::setprecision(2) << sw.get_seconds() << ")\n";);
+    }
+
     void simplifier::updt_params(params_ref const & _p) {
         sat_simplifier_params p(_p);
         m_cce                     = p.cce();
@@ -2102,6 +2312,9 @@ namespace sat {
         m_elim_vars               = p.elim_vars();
         m_elim_vars_bdd           = false && p.elim_vars_bdd(); // buggy?
         m_elim_vars_bdd_delay     = p.elim_vars_bdd_delay();
+        m_elim_vars_gates         = p.elim_vars_gates();
+        m_bva                     = p.bva();
+        m_bva_limit               = p.bva_limit();
         m_incremental_mode        = s.get_config().m_incremental && !p.override_incremental();
     }
 
@@ -2119,6 +2332,9 @@ namespace sat {
         st.update("sat abce", m_num_abce);
         st.update("sat bca",  m_num_bca);
         st.update("sat ate",  m_num_ate);
+        st.update("sat elim gates", m_num_elim_gates);
+        st.update("sat bva vars", m_num_bva_vars);
+        st.update("sat bva removed binaries", m_num_bva_bins);
     }
 
     void simplifier::reset_statistics() {
@@ -2132,5 +2348,8 @@ namespace sat {
         m_num_elim_vars = 0;
         m_num_bca = 0;
         m_num_ate = 0;
+        m_num_elim_gates = 0;
+        m_num_bva_vars = 0;
+        m_num_bva_bins = 0;
     }
 };
@@ -99,6 +99,9 @@ namespace sat {
         bool                   m_elim_vars;
         bool                   m_elim_vars_bdd;
         unsigned               m_elim_vars_bdd_delay;
+        bool                   m_elim_vars_gates;
+        bool                   m_bva;
+        unsigned               m_bva_limit;
 
         // stats
         unsigned               m_num_bce;
@@ -111,6 +114,9 @@ namespace sat {
         unsigned               m_num_elim_vars;
         unsigned               m_num_sub_res;
         unsigned               m_num_elim_lits;
+        unsigned               m_num_elim_gates;
+        unsigned               m_num_bva_vars;
+        unsigned               m_num_bva_bins;
 
         bool                   m_learned_in_use_lists;
         unsigned               m_old_num_elim_vars;
@@ -191,6 +197,10 @@ namespace sat {
         void collect_clauses(literal l, clause_wrapper_vector & r);
         clause_wrapper_vector m_pos_cls;
         clause_wrapper_vector m_neg_cls;
+        bool_vector           m_pos_gate;
+        bool_vector           m_neg_gate;
+        bool find_and_gate(literal l, clause_wrapper_vector const& l_cls, clause_wrapper_vector const& nl_cls, bool_vector& l_gate, bool_vector& nl_gate);
+        bool find_gate(literal pos_l);
         literal_vector m_new_cls;
         bool resolve(clause_wrapper const & c1, clause_wrapper const & c2, literal l, literal_vector & r);
         void save_clauses(model_converter::entry & mc_entry, clause_wrapper_vector const & cs);
@@ -200,6 +210,13 @@ namespace sat {
         bool try_eliminate(bool_var v);
         void elim_vars();
 
+        unsigned_vector m_bva_count;
+        bool_vector     m_bva_mark;
+        literal_vector  m_bva_lits, m_bva_partners, m_bva_touched, m_bva_tmp;
+        bool bva_enabled() const;
+        void bva_partners(literal l, literal_vector& partners);
+        void bva();
+
         struct blocked_cls_report;
         struct subsumption_report;
         struct elim_var_report;
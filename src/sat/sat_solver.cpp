@@ -330,6 +330,8 @@ namespace sat {
     void solver::set_eliminated(bool_var v, bool f) { 
         if (m_eliminated[v] && !f) 
             reset_var(v, m_external[v], m_decision[v]);
+        else if (!m_eliminated[v] && f)
+            ++m_num_eliminations;
         m_eliminated[v] = f; 
     }
 
@@ -671,6 +673,7 @@ namespace sat {
         SASSERT(new_sz > 2);
         SASSERT(old_sz >= new_sz);
         if (old_sz != new_sz) {
+            m_num_shrunk_literals += old_sz - new_sz;
             c.shrink(new_sz);
             for (literal l : c) {
                 m_touched[l.var()] = m_touch_index;
@@ -1570,6 +1573,8 @@ namespace sat {
             rlimit().reset_cancel();
         }
         set_par(nullptr, 0);
+        for (i_local_search* l : ls) 
+            l->collect_statistics(m_aux_stats);
         ls.reset();
         uw.reset();
         if (finished_id == -1) {
@@ -1924,6 +1929,86 @@ namespace sat {
     bool solver::should_simplify() const {
         return m_conflicts_since_init >= m_next_simplify;
     }
+    solver::inprocess_measure solver::get_inprocess_measure() const {
+        inprocess_measure r;
+        r.m_clauses = m_clauses.size() + m_learned.size();
+        r.m_units = m_trail.size();
+        r.m_bin_clauses = m_stats.m_mk_bin_clause;
+        r.m_eliminations = m_num_eliminations;
+        r.m_shrunk_literals = m_num_shrunk_literals;
+        return r;
+    }
+
+    /**
+       \brief Measure the yield of an inprocessing pass and schedule its next run.
+       A pass is productive if it removes clauses or literals, fixes literals, adds binary
+       clauses or eliminates variables. A pass that is not productive is postponed for
+       2, 4, 8 or 16 rounds.
+    */
+    class solver::inprocess_scope {
+        solver&           s;
+        inprocess_stats&  m_st;
+        inprocess_measure m_before;
+        stopwatch         m_watch;
+    public:
+        inprocess_scope(solver& s, inprocess_kind k): s(s), m_st(s.m_inprocess[k]), m_before(s.get_inprocess_measure()) {
+            m_watch.start();
+        }
+        ~inprocess_scope() {
+            m_watch.stop();
+            inprocess_measure after = s.get_inprocess_measure();
+            unsigned removed = 0;
+            if (after.m_clauses < m_before.m_clauses)
+                removed += m_before.m_clauses - after.m_clauses;
+            if (after.m_units > m_before.m_units)
+                removed += after.m_units - m_before.m_units;
+            bool productive = 
+                removed > 0 ||
+                after.m_bin_clauses > m_before.m_bin_clauses ||
+                after.m_eliminations > m_before.m_eliminations ||
+                after.m_shrunk_literals > m_before.m_shrunk_literals;
+            m_st.m_runs++;
+            m_st.m_time += m_watch.get_seconds();
+            m_st.m_removed += removed;
+            if (productive) 
+                m_st.m_unproductive = 0;
+            else if (m_st.m_unproductive < 4) 
+                m_st.m_unproductive++;
+            m_st.m_next = s.m_simplifications + (1u << m_st.m_unproductive);
+        }
+    };
+
+    bool solver::should_inprocess(inprocess_kind k) {
+        if (inconsistent())
+            return false;
+        inprocess_stats& st = m_inprocess[k];
+        if (m_config.m_inprocess_backoff && m_simplifications < st.m_next) {
+            st.m_skips++;
+            return false;
+        }
+        return true;
+    }
+
+    void solver::collect_inprocess_statistics(statistics& st) const {
+        static char const* names[ip_num_kinds][4] = {
+            { "sat inprocess probing runs",      "sat inprocess probing skips",      "sat inprocess probing removed",      "sat inprocess probing time" },
+            { "sat inprocess asymm branch runs", "sat inprocess asymm branch skips", "sat inprocess asymm branch removed", "sat inprocess asymm branch time" },
+            { "sat inprocess lookahead runs",    "sat inprocess lookahead skips",    "sat inprocess lookahead removed",    "sat inprocess lookahead time" },
+            { "sat inprocess binspr runs",       "sat inprocess binspr skips",       "sat inprocess binspr removed",       "sat inprocess binspr time" },
+            { "sat inprocess anf runs",          "sat inprocess anf skips",          "sat inprocess anf removed",          "sat inprocess anf time" },
+            { "sat inprocess cut runs",          "sat inprocess cut skips",          "sat inprocess cut removed",          "sat inprocess cut time" }
+        };
+        for (unsigned k = 0; k < ip_num_kinds; ++k) {
+            inprocess_stats const& s = m_inprocess[k];
+            if (s.m_runs == 0 && s.m_skips == 0)
+                continue;
+            st.update(names[k][0], s.m_runs);
+            st.update(names[k][1], s.m_skips);
+            st.update(names[k][2], s.m_removed);
+            st.update(names[k][3], s.m_time);
+        }
+    }
+
     /**
        \brief Apply all simplifications.
     */
@@ -1975,10 +2060,16 @@ namespace sat {
         sort_watch_lits();
         CASSERT("sat_simplify_bug", check_invariant());
 
-        m_probing();
+        if (should_inprocess(ip_probing)) {
+            inprocess_scope _scope(*this, ip_probing);
+            m_probing();
+        }
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
-        m_asymm_branch(false);
+        if (should_inprocess(ip_asymm_branch)) {
+            inprocess_scope _scope(*this, ip_asymm_branch);
+            m_asymm_branch(false);
+        }
 
         CASSERT("sat_missed_prop", check_missed_propagation());
         CASSERT("sat_simplify_bug", check_invariant());
@@ -1986,7 +2077,8 @@ namespace sat {
             m_ext->clauses_modifed();
             m_ext->simplify();
         }
-        if (m_config.m_lookahead_simplify && !m_ext) {
+        if (m_config.m_lookahead_simplify && !m_ext && should_inprocess(ip_lookahead)) {
+            inprocess_scope _scope(*this, ip_lookahead);
             lookahead lh(*this);
             lh.simplify(true);
             lh.collect_statistics(m_aux_stats);
@@ -2011,20 +2103,22 @@ namespace sat {
             }
         }
 
-        if (m_config.m_binspr && !inconsistent()) {
+        if (m_config.m_binspr && should_inprocess(ip_binspr)) {
+            inprocess_scope _scope(*this, ip_binspr);
             m_binspr();
         }
 
-        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && !inconsistent()) {
+        if (m_config.m_anf_simplify && m_simplifications > m_config.m_anf_delay && should_inprocess(ip_anf)) {
+            inprocess_scope _scope(*this, ip_anf);
             anf_simplifier anf(*this);
             anf_simplifier::config cfg;
             cfg.m_enable_exlin = m_config.m_anf_exlin;
             anf();
             anf.collect_statistics(m_aux_stats);
-            // TBD: throttle anf_delay based on yield
         }
         
-        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && !inconsistent()) {
+        if (m_cut_simplifier && m_simplifications > m_config.m_cut_delay && should_inprocess(ip_cut)) {
+            inprocess_scope _scope(*this, ip_cut);
             (*m_cut_simplifier)();
         }
 
@@ -2561,7 +2655,7 @@ namespace sat {
         
         if (use_backjumping(num_scopes)) {
             ++m_stats.m_backjumps;
-            pop_reinit(num_scopes);
+            pop_reinit(num_scopes - reuse_trail_scopes(backjump_lvl, backtrack_lvl));
         }
         else {
             TRACE("sat", tout << "backtrack " << (m_scope_lvl - backtrack_lvl + 1) << " scopes\n";);
@@ -2587,6 +2681,32 @@ namespace sat {
             (num_scopes <= m_config.m_backtrack_scopes || !allow_backtracking());
     }
 
+    /**
+       \brief Number of decision levels above backjump_lvl that can stay on the trail
+       because their decisions are more active than the next decision variable.
+       The literal asserted by the lemma is at backtrack_lvl, so that level is popped.
+       Assigned and eliminated variables are removed from the queue, as in next_var();
+       the ones that are unassigned by the backjump are put back by unassign_var_eh.
+    */
+    unsigned solver::reuse_trail_scopes(unsigned backjump_lvl, unsigned backtrack_lvl) {
+        if (!m_config.m_backtrack_reuse_trail || !allow_backtracking())
+            return 0;
+        while (!m_case_split_queue.empty()) {
+            bool_var v = m_case_split_queue.min_var();
+            if (value(v) == l_undef && !was_eliminated(v))
+                break;
+            m_case_split_queue.next_var();
+        }
+        if (m_case_split_queue.empty())
+            return 0;
+        bool_var next = m_case_split_queue.min_var();
+        unsigned n = backjump_lvl;
+        for (; n + 1 < backtrack_lvl && m_case_split_queue.more_active(scope_literal(n).var(), next); ++n) {
+        }
+        m_stats.m_reused_scopes += n - backjump_lvl;
+        return n - backjump_lvl;
+    }
+
     bool solver::allow_backtracking() const {
         return m_conflicts_since_init > m_config.m_backtrack_init_conflicts;
     }
@@ -3805,6 +3925,7 @@ namespace sat {
         if (m_ext) m_ext->collect_statistics(st);
         if (m_local_search) m_local_search->collect_statistics(st);
         if (m_cut_simplifier) m_cut_simplifier->collect_statistics(st);
+        collect_inprocess_statistics(st);
         st.copy(m_aux_stats);
     }
 
@@ -3814,6 +3935,10 @@ namespace sat {
         m_simplifier.reset_statistics();
         m_asymm_branch.reset_statistics();
         m_probing.reset_statistics();
+        for (inprocess_stats& s : m_inprocess) {
+            s.m_runs = s.m_skips = s.m_removed = 0;
+            s.m_time = 0;
+        }
         m_aux_stats.reset();
     }
 
@@ -4785,6 +4910,7 @@ namespace sat {
         st.update("sat elim bool vars bdd", m_elim_var_bdd);
         st.update("sat backjumps", m_backjumps);
         st.update("sat backtracks", m_backtracks);
+        st.update("sat reused scopes", m_reused_scopes);
     }
 
     void stats::reset() {
@@ -74,6 +74,7 @@ namespace sat {
         unsigned m_units;
         unsigned m_backtracks;
         unsigned m_backjumps;
+        unsigned m_reused_scopes;
         stats() { reset(); }
         void reset();
         void collect_statistics(statistics & st) const;
@@ -124,6 +125,8 @@ namespace sat {
         bool_vector             m_mark;
         bool_vector             m_lit_mark;
         bool_vector             m_eliminated;
+        unsigned                m_num_eliminations { 0 };    // variables marked as eliminated so far
+        uint64_t                m_num_shrunk_literals { 0 }; // literals removed from clauses by shrink()
         bool_vector             m_external;
         unsigned_vector         m_var_scope;
         unsigned_vector         m_touched;
@@ -515,6 +518,38 @@ namespace sat {
         bool is_assumption(literal l) const;
         bool should_simplify() const;
         void do_simplify();
+
+        // inprocessing scheduler: passes that do not remove clauses or literals, fix literals,
+        // add binary clauses or eliminate variables are skipped for exponentially many rounds.
+        enum inprocess_kind {
+            ip_probing,
+            ip_asymm_branch,
+            ip_lookahead,
+            ip_binspr,
+            ip_anf,
+            ip_cut,
+            ip_num_kinds
+        };
+        struct inprocess_stats {
+            unsigned m_runs { 0 };
+            unsigned m_skips { 0 };
+            unsigned m_removed { 0 };
+            unsigned m_unproductive { 0 };
+            unsigned m_next { 0 };
+            double   m_time { 0 };
+        };
+        struct inprocess_measure {
+            unsigned m_clauses;
+            unsigned m_units;
+            unsigned m_bin_clauses;     // binary clauses created so far
+            unsigned m_eliminations;    // variables eliminated so far, including the ones merged by equivalences
+            uint64_t m_shrunk_literals; // literals removed from clauses so far
+        };
+        class inprocess_scope;
+        inprocess_stats m_inprocess[ip_num_kinds];
+        bool should_inprocess(inprocess_kind k);
+        inprocess_measure get_inprocess_measure() const;
+        void collect_inprocess_statistics(statistics& st) const;
         void mk_model();
         bool check_model(model const & m) const;
         void do_restart(bool to_base);
@@ -590,6 +625,7 @@ namespace sat {
         literal_vector m_lemma;
         literal_vector m_ext_antecedents;
         bool use_backjumping(unsigned num_scopes) const;
+        unsigned reuse_trail_scopes(unsigned backjump_lvl, unsigned backtrack_lvl);
         bool allow_backtracking() const;
         bool resolve_conflict();
         lbool resolve_conflict_core();
@@ -250,6 +250,8 @@ namespace sat {
         virtual model const& get_model() const = 0;
         virtual void collect_statistics(statistics& st) const = 0;        
         virtual double get_priority(bool_var v) const { return 0; }
+        virtual unsigned get_best_num_unsat() const { return UINT_MAX; }
+        virtual bool get_best_value(bool_var v) const { return false; }
 
     };
 
@@ -39,6 +39,7 @@ namespace arith {
         lp().settings().enable_hnf() = lpar.arith_enable_hnf();
         lp().settings().print_external_var_name() = lpar.arith_print_ext_var_names();
         lp().set_track_pivoted_rows(lpar.arith_bprop_on_pivoted_rows());
+        lp().settings().max_cells_for_bound_propagation = lpar.arith_bprop_max_cells();
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
         lp().settings().cheap_eqs() = lpar.arith_propagate_eqs();
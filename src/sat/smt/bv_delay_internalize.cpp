@@ -29,6 +29,10 @@ namespace bv {
         switch (to_app(e)->get_decl_kind()) {
         case OP_BMUL:
             return check_mul(to_app(e));
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
+            return check_shift(to_app(e));
         case OP_BSMUL_NO_OVFL:
         case OP_BSMUL_NO_UDFL:
         case OP_BUMUL_NO_OVFL:
@@ -44,7 +48,7 @@ namespace bv {
             return true;
         unsigned num_vars = e->get_num_args();
         for (expr* arg : *e) 
-            if (!m.is_value(arg))
+            if (m.is_value(arg))
                 --num_vars;
         if (num_vars <= 1) 
             return true;
@@ -79,6 +83,8 @@ namespace bv {
             return true;
 
         TRACE("bv", tout << mk_bounded_pp(e, m) << " evaluates to " << r1 << " arguments: " << args << "\n";);
+        repair_phases(e, args, r1, r2);
+
         // check x*0 = 0
         if (!check_mul_zero(e, args, r1, r2))
             return false;
@@ -91,14 +97,16 @@ namespace bv {
         if (!check_mul_invertibility(e, args, r1))
             return false;
 
+        // Hensel lifting:
+        // Fix the low order bits where multiplication is correct, 
+        // and propagate on the next bit that shows a discrepancy.
+        if (!check_low_bits(e, r1, r2))
+            return false;
+
         // Some other possible approaches:
         // algebraic rules:
         // x*(y+z), and there are nodes for x*y or x*z -> x*(y+z) = x*y + x*z
         // compute S-polys for a set of constraints.
-      
-        // Hensel lifting:
-        // The idea is dual to fixing high-order bits. Fix the low order bits where multiplication
-        // is correct, and propagate on the next bit that shows a discrepancy.
 
         // check Montgommery properties: (x*y) mod p = (x mod p)*(y mod p) for small primes p
 
@@ -110,8 +118,161 @@ namespace bv {
         if (m_cheap_axioms)
             return true;
 
+        delay_bit_blast(e);
+        return false;
+    }
+
+    /**
+     * The i'th bit of a sum or product is determined by bits 0..i of the arguments.
+     * For the lowest bit where the current value of n differs from the value of 
+     * its evaluated arguments, add the clause
+     * 
+     *   x[0..i] = x0[0..i] & y[0..i] = y0[0..i] => n[i] = value2[i]
+     * 
+     * The number of such lemmas is bounded by the bit-width of n, after which
+     * n is left to bit-blasting.
+     */
+    bool solver::check_low_bits(app* n, expr* value1, expr* value2) {
+        rational v1, v2;
+        unsigned sz;
+        VERIFY(bv.is_numeral(value1, v1, sz));
+        VERIFY(bv.is_numeral(value2, v2));
+        SASSERT(v1 != v2);
+        if (!m_low_bits_lemmas.contains(n)) 
+            ctx.push(insert_obj_map<euf::solver, expr, unsigned>(m_low_bits_lemmas, n));
+        unsigned& num_lemmas = m_low_bits_lemmas.insert_if_not_there(n, 0);
+        if (num_lemmas >= sz)
+            return true;
+        ++num_lemmas;
+        unsigned i = 0;
+        rational two(2);
+        for (; v1.is_even() == v2.is_even(); ++i) {
+            v1 = div(v1, two);
+            v2 = div(v2, two);
+        }
+        SASSERT(i < sz);
+        sat::literal_vector lits;
+        auto bit_value = [&](sat::literal b) {
+            return s().value(b) == l_true ? ~b : b;
+        };
+        for (expr* arg : *n) {
+            sat::literal_vector const& bits = m_bits[expr2enode(arg)->get_th_var(get_id())];
+            for (unsigned j = 0; j <= i; ++j)
+                lits.push_back(bit_value(bits[j]));
+        }
+        lits.push_back(bit_value(m_bits[expr2enode(n)->get_th_var(get_id())][i]));
+        ++m_stats.m_num_low_bits_lemmas;
+        add_clause(lits);
+        return false;
+    }
+
+    /**
+     * Word-level repair of a delayed operator n whose current value, value1, 
+     * differs from value2, the value of n computed from its arguments.
+     * Alternately move n to value2, or keep n and move its first argument to 
+     * the value given by the inverse operator: x := n - y for additions and
+     * x := n * y^-1 for multiplications by an odd y.
+     * The repair is recorded in the saved phases of the bits, which the SAT
+     * solver uses once it backjumps from the current assignment.
+     */
+    void solver::repair_phases(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2) {
+        rational v1, v2, y, inv;
+        unsigned sz;
+        VERIFY(bv.is_numeral(value1, v1, sz));
+        VERIFY(bv.is_numeral(value2, v2));
+        ++m_stats.m_num_repairs;
+        bool backward = m_repair_backward && arg_values.size() == 2 && bv.is_numeral(arg_values.get(1), y);
+        m_repair_backward = !m_repair_backward;
+        rational N = rational::power_of_two(sz);
+        if (backward && bv.is_bv_add(n)) 
+            set_phases(n->get_arg(0), mod(v1 - y, N));
+        else if (backward && bv.is_bv_mul(n) && !y.is_even() && bv.mult_inverse(y, sz, inv)) 
+            set_phases(n->get_arg(0), mod(v1 * inv, N));
+        else 
+            set_phases(n, v2);
+    }
+
+    void solver::set_phases(expr* e, rational const& value) {
+        theory_var v = expr2enode(e)->get_th_var(get_id());
+        rational r(value), two(2);
+        for (sat::literal b : m_bits[v]) {
+            s().set_phase(r.is_even() ? ~b : b);
+            r = div(r, two);
+        }
+    }
+
+    /**
+     * Bit-blast a delayed operator whose evaluation was violated by the
+     * current assignment and could not be repaired using cheap axioms.
+     */
+    void solver::delay_bit_blast(app* e) {
+        ++m_stats.m_num_delay_blasts;
         set_delay_internalize(e, internalize_mode::no_delay_i);
         internalize_circuit(e);
+    }
+
+    /**
+     * Check a delayed shift against the values of its arguments.
+     * Shifts by 0 and by at least the bit-width are repaired with axioms 
+     * that do not depend on the shifted value, other violations bit-blast 
+     * the shifter.
+     */
+    bool solver::check_shift(app* e) {
+        expr_ref_vector args(m);
+        euf::enode* n = expr2enode(e);
+        auto r1 = eval_bv(n);
+        auto r2 = eval_args(n, args);
+        if (r1 == r2)
+            return true;
+
+        TRACE("bv", tout << mk_bounded_pp(e, m) << " evaluates to " << r1 << " arguments: " << args << "\n";);
+        repair_phases(e, args, r1, r2);
+
+        // check x << 0 = x
+        if (!check_shift_zero(e, args))
+            return false;
+
+        // check x << y = 0 for y >= sz
+        if (!check_shift_overflow(e, args))
+            return false;
+
+        if (m_cheap_axioms)
+            return true;
+
+        delay_bit_blast(e);
+        return false;
+    }
+
+    /**
+     * y = 0 => x << y = x
+     */
+    bool solver::check_shift_zero(app* n, expr_ref_vector const& arg_values) {
+        if (!bv.is_zero(arg_values.get(1)))
+            return true;
+        sat::literal is_zero = eq_internalize(n->get_arg(1), arg_values.get(1));
+        add_clause(~is_zero, eq_internalize(n, n->get_arg(0)));
+        ++m_stats.m_num_delay_axioms;
+        return false;
+    }
+
+    /**
+     * y >= sz => x << y = 0
+     * y >= sz => x >>a y = x >>a (sz - 1)
+     */
+    bool solver::check_shift_overflow(app* n, expr_ref_vector const& arg_values) {
+        rational val;
+        unsigned sz = bv.get_bv_size(n);
+        VERIFY(bv.is_numeral(arg_values.get(1), val));
+        if (val < sz)
+            return true;
+        expr_ref ge(bv.mk_ule(bv.mk_numeral(sz, sz), n->get_arg(1)), m);
+        expr_ref r(m);
+        if (bv.is_bv_ashr(n))
+            r = bv.mk_bv_ashr(n->get_arg(0), bv.mk_numeral(sz - 1, sz));
+        else
+            r = bv.mk_numeral(0, sz);
+        add_clause(~mk_literal(ge), eq_internalize(n, r));
+        ++m_stats.m_num_delay_axioms;
         return false;
     }
 
@@ -165,6 +326,8 @@ namespace bv {
     /*
     * Check that multiplication with 0 is correctly propagated.
     * If not, create algebraic axioms enforcing 0*x = 0 and x*0 = 0
+    * for the arguments that are 0. The product of non-zero arguments
+    * can also be 0, those cases are left to the other checks.
     * 
     * z = 0, then lsb(x) + 1 + lsb(y) + 1 >= sz
 
@@ -173,18 +336,17 @@ namespace bv {
         SASSERT(mul_value != arg_value);
         SASSERT(!(bv.is_zero(mul_value) && bv.is_zero(arg_value)));
         if (bv.is_zero(arg_value)) {
-            unsigned sz = n->get_num_args();
-            expr_ref_vector args(m, sz, n->get_args());
-            for (unsigned i = 0; i < sz && !s().inconsistent(); ++i) {
-
-                args[i] = arg_value;
-                expr_ref r(m.mk_app(n->get_decl(), args), m);
-                set_delay_internalize(r, internalize_mode::init_bits_only_i); // do not bit-blast this multiplier.
-                args[i] = n->get_arg(i);                
-                add_unit(eq_internalize(r, arg_value));
+            bool added = false;
+            for (unsigned i = 0; i < arg_values.size() && !s().inconsistent(); ++i) {
+                if (!bv.is_zero(arg_values.get(i)))
+                    continue;
+                add_clause(~eq_internalize(n->get_arg(i), arg_value), eq_internalize(n, arg_value));
+                added = true;
+            }
+            if (added) {
+                IF_VERBOSE(2, verbose_stream() << "delay internalize @" << s().scope_lvl() << "\n");
+                return false;
             }
-            IF_VERBOSE(2, verbose_stream() << "delay internalize @" << s().scope_lvl() << "\n");
-            return false;
         }
         if (bv.is_zero(mul_value)) {
             return true;
@@ -318,10 +480,12 @@ namespace bv {
         auto r2 = eval_args(n, args);
         if (r1 == r2)
             return true;
+        repair_phases(a, args, r1, r2);
+        if (bv.is_bv_add(a) && !check_low_bits(a, r1, r2))
+            return false;
         if (m_cheap_axioms)
             return true;
-        set_delay_internalize(a, internalize_mode::no_delay_i);
-        internalize_circuit(a);
+        delay_bit_blast(a);
         return false;
     }
 
@@ -338,8 +502,7 @@ namespace bv {
             return false;
         if (m_cheap_axioms)
             return true;
-        set_delay_internalize(a, internalize_mode::no_delay_i);
-        internalize_circuit(a);
+        delay_bit_blast(a);
         return false;
     }
 
@@ -367,6 +530,9 @@ namespace bv {
         case OP_BSREM_I:
         case OP_BUDIV_I:
         case OP_BSDIV_I: 
+        case OP_BSHL:
+        case OP_BLSHR:
+        case OP_BASHR:
         case OP_BADD:
             if (should_bit_blast(to_app(e)))
                 return internalize_mode::no_delay_i;
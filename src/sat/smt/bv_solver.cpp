@@ -662,6 +662,10 @@ namespace bv {
         st.update("bv bit2eq", m_stats.m_num_bit2eq);
         st.update("bv bit2ne", m_stats.m_num_bit2ne);
         st.update("bv ackerman", m_stats.m_ackerman);
+        st.update("bv delay axioms", m_stats.m_num_delay_axioms);
+        st.update("bv delay bit-blasts", m_stats.m_num_delay_blasts);
+        st.update("bv low bits lemmas", m_stats.m_num_low_bits_lemmas);
+        st.update("bv phase repairs", m_stats.m_num_repairs);
     }
 
     sat::extension* solver::copy(sat::solver* s) { UNREACHABLE(); return nullptr; }
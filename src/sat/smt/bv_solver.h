@@ -46,6 +46,8 @@ namespace bv {
             unsigned   m_num_diseq_static, m_num_diseq_dynamic,  m_num_conflicts;
             unsigned   m_num_bit2eq, m_num_bit2ne, m_num_eq2bit, m_num_ne2bit;
             unsigned   m_ackerman;
+            unsigned   m_num_delay_axioms, m_num_delay_blasts, m_num_low_bits_lemmas;
+            unsigned   m_num_repairs;
             void reset() { memset(this, 0, sizeof(stats)); }
             stats() { reset(); }
         };
@@ -264,7 +266,9 @@ namespace bv {
         };
 
         obj_map<expr, internalize_mode> m_delay_internalize;
+        obj_map<expr, unsigned> m_low_bits_lemmas;
         bool m_cheap_axioms{ true };
+        bool m_repair_backward{ false }; // alternate forward and backward moves in repair_phases
         bool should_bit_blast(app * n);
         bool check_delay_internalized(expr* e);
         bool check_mul(app* e);
@@ -272,6 +276,13 @@ namespace bv {
         bool check_mul_zero(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_mul_one(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
         bool check_umul_no_overflow(app* n, expr_ref_vector const& arg_values, expr* value);
+        bool check_low_bits(app* n, expr* value1, expr* value2);
+        bool check_shift(app* e);
+        bool check_shift_zero(app* n, expr_ref_vector const& arg_values);
+        bool check_shift_overflow(app* n, expr_ref_vector const& arg_values);
+        void delay_bit_blast(app* e);
+        void repair_phases(app* n, expr_ref_vector const& arg_values, expr* value1, expr* value2);
+        void set_phases(expr* e, rational const& value);
         bool check_bv_eval(euf::enode* n);
         bool check_bool_eval(euf::enode* n);
         void encode_msb_tail(expr* x, expr_ref_vector& xs);
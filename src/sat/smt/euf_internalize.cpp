@@ -86,6 +86,10 @@ namespace euf {
     }
 
     bool solver::post_visit(expr* e, bool sign, bool root) {
+        // internalizing the arguments may have internalized e,
+        // e.g., when bit-vector constants trigger equality propagation.
+        if (visited(e))
+            return true;
         unsigned num = is_app(e) ? to_app(e)->get_num_args() : 0;
         m_args.reset();
         for (unsigned i = 0; i < num; ++i)
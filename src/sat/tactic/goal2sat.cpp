@@ -61,6 +61,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
     svector<frame>              m_frame_stack;
     svector<sat::literal>       m_result_stack;
     obj_map<app, sat::literal>  m_cache;
+    obj_hashtable<app>          m_redundant_cache; // gates in m_cache that are defined by redundant clauses
     obj_hashtable<expr>         m_interface_vars;
     sat::solver_core &          m_solver;
     atom2bool_var &             m_map;
@@ -252,11 +253,16 @@ struct goal2sat::imp : public sat::sat_internalizer {
         n -= m_num_scopes;
         m_num_scopes = 0;
         m_cache.reset();
+        m_redundant_cache.reset();
         m_map.pop(n);
     }
 
     void cache(app* t, sat::literal l) override {
         m_cache.insert(t, l);
+        if (m_is_redundant)
+            m_redundant_cache.insert(t);
+        else
+            m_redundant_cache.remove(t);
     }
 
    void convert_atom(expr * t, bool root, bool sign) {
@@ -319,6 +325,15 @@ struct goal2sat::imp : public sat::sat_internalizer {
         sat::literal l = sat::null_literal;
         if (!m_cache.find(t, l))
             return false;
+        // gates that are created during search may be shared with gates
+        // whose variables were eliminated by inprocessing, or with gates
+        // defined by redundant clauses that can be garbage collected.
+        // Re-create them.
+        if ((!m_is_redundant && m_redundant_cache.contains(t)) ||
+            (m_euf && ensure_euf()->s().was_eliminated(l.var()))) {
+            m_cache.remove(t);
+            return false;
+        }
         if (sign)
             l.neg();
         if (root)
@@ -396,7 +411,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             SASSERT(num <= m_result_stack.size());
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            m_cache.insert(t, l);
+            cache(t, l);
             sat::literal * lits = m_result_stack.end() - num;       
             for (unsigned i = 0; i < num; i++) 
                 mk_clause(~lits[i], l);
@@ -445,7 +460,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             SASSERT(num <= m_result_stack.size());
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            m_cache.insert(t, l);
+            cache(t, l);
             sat::literal * lits = m_result_stack.end() - num;
 
             // l => /\ lits
@@ -497,7 +512,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         else {
             sat::bool_var k = add_var(false, n);
             sat::literal  l(k, false);
-            m_cache.insert(n, l);
+            cache(n, l);
             mk_clause(~l, ~c, t);
             mk_clause(~l,  c, e);
             mk_clause(l,  ~c, ~t);
@@ -534,7 +549,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
         else {
             sat::bool_var k = add_var(false, t);
             sat::literal  l(k, false);
-            m_cache.insert(t, l);
+            cache(t, l);
             // l <=> (l1 => l2)
             mk_clause(~l, ~l1, l2);
             mk_clause(l1, l);
@@ -571,7 +586,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             mk_clause(l,  l1, l2);
             mk_clause(l, ~l1, ~l2);
             if (aig()) aig()->add_iff(l, l1, l2);            
-            m_cache.insert(t, m.is_xor(t) ? ~l : l);
+            cache(t, m.is_xor(t) ? ~l : l);
             if (sign)
                 l.neg();
             m_result_stack.push_back(l);
@@ -854,6 +869,7 @@ struct goal2sat::imp : public sat::sat_internalizer {
             ~scoped_reset() {
                 i.m_interface_vars.reset();
                 i.m_cache.reset();
+                i.m_redundant_cache.reset();
             }
         };
         scoped_reset _reset(*this);
@@ -34,6 +34,7 @@ void theory_arith_params::updt_params(params_ref const & _p) {
     m_arith_int_eq_branching = p.arith_int_eq_branch();
     m_arith_ignore_int = p.arith_ignore_int();
     m_arith_bound_prop = static_cast<bound_prop_mode>(p.arith_propagation_mode());
+    m_arith_dl_implied_edges = p.arith_dl_implied_edges();
     m_arith_dump_lemmas = p.arith_dump_lemmas();
     m_arith_reflect = p.arith_reflect();
     m_arith_eager_eq_axioms = p.arith_eager_eq_axioms();
@@ -54,6 +55,7 @@ void theory_arith_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_arith_blands_rule_threshold);
     DISPLAY_PARAM(m_arith_propagate_eqs);
     DISPLAY_PARAM((unsigned)m_arith_bound_prop);
+    DISPLAY_PARAM(m_arith_dl_implied_edges);
     DISPLAY_PARAM(m_arith_stronger_lemmas);
     DISPLAY_PARAM(m_arith_skip_rows_with_big_coeffs);
     DISPLAY_PARAM(m_arith_max_lemma_size);
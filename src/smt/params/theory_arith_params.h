@@ -58,6 +58,7 @@ struct theory_arith_params {
     unsigned                m_arith_blands_rule_threshold;
     bool                    m_arith_propagate_eqs;
     bound_prop_mode         m_arith_bound_prop; 
+    bool                    m_arith_dl_implied_edges; //!< propagate atoms implied by new edges in the sparse difference logic solver
     bool                    m_arith_stronger_lemmas;
     bool                    m_arith_skip_rows_with_big_coeffs;
     unsigned                m_arith_max_lemma_size; 
@@ -117,6 +118,7 @@ struct theory_arith_params {
         m_arith_blands_rule_threshold(1000),
         m_arith_propagate_eqs(true),
         m_arith_bound_prop(bound_prop_mode::BP_REFINE),
+        m_arith_dl_implied_edges(false),
         m_arith_stronger_lemmas(true),
         m_arith_skip_rows_with_big_coeffs(true),
         m_arith_max_lemma_size(128),
@@ -29,6 +29,7 @@ Revision History:
 #include "ast/proofs/proof_checker.h"
 #include "ast/ast_util.h"
 #include "ast/well_sorted.h"
+#include "ast/rewriter/th_rewriter.h"
 #include "model/model.h"
 #include "model/model_pp.h"
 #include "smt/smt_context.h"
@@ -3533,6 +3534,28 @@ namespace smt {
         setup_components();
     }
 
+    /**
+       \brief Configure the context using the static features of formulas
+       that are asserted after a scope is pushed. The formulas are simplified
+       first, as the asserted formulas are by preprocessing.
+    */
+    void context::setup_context(ptr_vector<expr> const & fmls) {
+        if (m_setup.already_configured() || inconsistent()) 
+            return;
+        th_rewriter rw(m);
+        expr_ref_vector simp_fmls(m);
+        ptr_vector<expr> simp_ptrs;
+        for (expr * f : fmls) {
+            expr_ref r(m);
+            rw(f, r);
+            simp_fmls.push_back(r);
+            simp_ptrs.push_back(r);
+        }
+        m_setup(get_config_mode(m_fparams.m_auto_config), simp_ptrs);
+        m_relevancy_lvl = m_fparams.m_relevancy_lvl;
+        setup_components();
+    }
+
     void context::setup_components() {
         m_asserted_formulas.setup();
         m_random.set_seed(m_fparams.m_random_seed);
@@ -1679,6 +1679,10 @@ namespace smt {
 
         void get_asserted_formulas(ptr_vector<expr>& r) const { m_asserted_formulas.get_assertions(r); }
 
+        bool already_configured() const { return m_setup.already_configured(); }
+
+        void setup_context(ptr_vector<expr> const & fmls);
+
         //proof * const * get_asserted_formula_proofs() const { return m_asserted_formulas.get_formula_proofs(); }
 
         void get_assertions(ptr_vector<expr> & result) { m_asserted_formulas.get_assertions(result); }
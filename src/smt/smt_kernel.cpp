@@ -27,10 +27,22 @@ namespace smt {
     struct kernel::imp {
         smt::context m_kernel;
         params_ref   m_params;
+        bool         m_fast_reset;
+        bool         m_base_pushed;      // assertions are kept above a scope pushed after reset
+        bool         m_base_pending;     // the scope is pushed before the next assertion, push or check
+        expr_ref_vector  m_deferred;     // assertions kept until the context is set up, see defer
+        proof_ref_vector m_deferred_prs;
+        unsigned     m_num_fast_resets;
         
         imp(ast_manager & m, smt_params & fp, params_ref const & p):
             m_kernel(m, fp, p),
-            m_params(p) {
+            m_params(p),
+            m_base_pushed(false),
+            m_base_pending(false),
+            m_deferred(m),
+            m_deferred_prs(m),
+            m_num_fast_resets(0) {
+            m_fast_reset = smt_params_helper(p).fast_reset();
         }
 
         static void copy(imp& src, imp& dst) {
@@ -60,10 +72,10 @@ namespace smt {
         void display(std::ostream & out) const {
             // m_kernel.display(out); <<< for external users it is just junk
             // TODO: it will be replaced with assertion_stack.display
-            unsigned num = m_kernel.get_num_asserted_formulas();
+            unsigned num = size();
             out << "(kernel";
             for (unsigned i = 0; i < num; i++) {
-                expr* f = m_kernel.get_asserted_formula(i);
+                expr* f = get_formula(i);
                 out << "\n  " << mk_ismt2_pp(f, m(), 2);
             }
             out << ")";
@@ -71,27 +83,36 @@ namespace smt {
         
         void assert_expr(expr * e) {
             TRACE("smt_kernel", tout << "assert:\n" << mk_ismt2_pp(e, m()) << "\n";);
+            if (defer(e, nullptr))
+                return;
+            ensure_base();
             m_kernel.assert_expr(e);
         }
         
         void assert_expr(expr * e, proof * pr) {
+            if (defer(e, pr))
+                return;
+            ensure_base();
             m_kernel.assert_expr(e, pr);
         }
 
         unsigned size() const {
-            return m_kernel.get_num_asserted_formulas();
+            return m_kernel.get_num_asserted_formulas() + m_deferred.size();
         }
         
         void get_formulas(ptr_vector<expr>& fmls) const {
             m_kernel.get_asserted_formulas(fmls);
+            fmls.append(m_deferred.size(), m_deferred.c_ptr());
         }
 
         expr* get_formula(unsigned i) const {
-            return m_kernel.get_asserted_formula(i);
+            unsigned num = m_kernel.get_num_asserted_formulas();
+            return i < num ? m_kernel.get_asserted_formula(i) : m_deferred.get(i - num);
         }
         
         void push() {
             TRACE("smt_kernel", tout << "push()\n";);
+            ensure_base();
             m_kernel.push();
         }
 
@@ -101,10 +122,67 @@ namespace smt {
         }
         
         unsigned get_scope_level() const {
-            return m_kernel.get_scope_level();
+            return m_kernel.get_scope_level() - (m_base_pushed ? 1 : 0);
+        }
+
+        /**
+           \brief Keep the assertions made after a reset that rebuilt the context 
+           until the next push or check. Pushing a scope sets up the context, 
+           and setup_and_check uses the static features of these assertions.
+        */
+        bool defer(expr * e, proof * pr) {
+            if (!m_base_pending || m_kernel.already_configured())
+                return false;
+            m_deferred.push_back(e);
+            m_deferred_prs.push_back(pr);
+            return true;
+        }
+
+        /**
+           \brief Push the scope that holds the assertions after a reset.
+           It is pushed lazily, so a kernel that is reset several times without
+           being used does not set up the context.
+        */
+        void ensure_base(bool use_static_features = false) {
+            if (!m_base_pending)
+                return;
+            m_base_pending = false;
+            if (use_static_features && !m_deferred.empty()) {
+                ptr_vector<expr> fmls(m_deferred.size(), m_deferred.c_ptr());
+                m_kernel.setup_context(fmls);
+            }
+            m_kernel.push();
+            m_base_pushed = true;
+            for (unsigned i = 0; i < m_deferred.size(); ++i)
+                m_kernel.assert_expr(m_deferred.get(i), m_deferred_prs.get(i));
+            m_deferred.reset();
+            m_deferred_prs.reset();
+        }
+
+        /**
+           \brief Erase all assertions by popping the scope pushed after the previous reset.
+           The theories, the setup and the memory of the context are kept.
+           Return false if there is no such scope, and the context has to be rebuilt.
+        */
+        bool reset_to_base() {
+            if (m_base_pushed) {
+                m_kernel.pop(m_kernel.get_scope_level());
+                m_base_pushed = false;
+                m_base_pending = true;
+            }
+            if (!m_base_pending)
+                return false;
+            m_deferred.reset();
+            m_deferred_prs.reset();
+            m_num_fast_resets++;
+            return true;
         }
 
         lbool setup_and_check() {
+            ensure_base(true);
+            // the context is set up when the scope is pushed.
+            if (m_base_pushed)
+                return m_kernel.check();
             return m_kernel.setup_and_check();
         }
 
@@ -113,22 +191,27 @@ namespace smt {
         }
         
         lbool check(unsigned num_assumptions, expr * const * assumptions) {
+            ensure_base();
             return m_kernel.check(num_assumptions, assumptions);
         }
 
         lbool check(expr_ref_vector const& cube, vector<expr_ref_vector> const& clause) {
+            ensure_base();
             return m_kernel.check(cube, clause);
         }        
 
         lbool get_consequences(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector& conseq, expr_ref_vector& unfixed) {
+            ensure_base();
             return m_kernel.get_consequences(assumptions, vars, conseq, unfixed);
         }
 
         lbool preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores) {
+            ensure_base();
             return m_kernel.preferred_sat(asms, cores);
         }
 
         lbool find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) {
+            ensure_base();
             return m_kernel.find_mutexes(vars, mutexes);
         }
         
@@ -189,17 +272,21 @@ namespace smt {
         }
 
         expr_ref next_cube() {
+            ensure_base();
             lookahead lh(m_kernel);
             return lh.choose();
         }
 
         expr_ref_vector cubes(unsigned depth) {
+            ensure_base();
             lookahead lh(m_kernel);
             return lh.choose_rec(depth);
         }
                 
         void collect_statistics(::statistics & st) const {
             m_kernel.collect_statistics(st);
+            if (m_fast_reset)
+                st.update("smt fast resets", m_num_fast_resets);
         }
 
         void reset_statistics() {
@@ -219,6 +306,7 @@ namespace smt {
 
         void updt_params(params_ref const & p) {
             m_kernel.updt_params(p);
+            m_fast_reset = smt_params_helper(p).fast_reset();
         }
 
         void user_propagate_init(
@@ -226,6 +314,7 @@ namespace smt {
             solver::push_eh_t&       push_eh,
             solver::pop_eh_t&        pop_eh,
             solver::fresh_eh_t&      fresh_eh) {
+            ensure_base();
             m_kernel.user_propagate_init(ctx, push_eh, pop_eh, fresh_eh);
         }
 
@@ -311,11 +400,16 @@ namespace smt {
     }
 
     void kernel::reset() {
+        bool fast_reset = m_imp->m_fast_reset;
+        if (fast_reset && m_imp->reset_to_base())
+            return;
         ast_manager & _m = m();
         smt_params & fps = m_imp->fparams();
         params_ref ps    = m_imp->params();
         m_imp->~imp();
         m_imp = new (m_imp) imp(_m, fps, ps);        
+        m_imp->m_fast_reset = fast_reset;
+        m_imp->m_base_pending = fast_reset;
     }
 
     bool kernel::inconsistent() {
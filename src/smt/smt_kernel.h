@@ -110,6 +110,13 @@ namespace smt {
         /**
            \brief Reset the kernel.
            All assertions are erased.
+
+           With smt.fast_reset, the context is rebuilt only on the first reset. Later
+           resets pop the assertions, and the theories and allocated structures are reused.
+           The assertions are then kept above the base level. The context is set up with the
+           static features of the assertions made before the first check after the first reset,
+           and later resets keep that setup. Preprocessing that only runs at the base level is
+           skipped, so theory solvers and performance can differ.
         */
         void reset();
 
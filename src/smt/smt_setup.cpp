@@ -67,6 +67,21 @@ namespace smt {
         setup_card();
     }
 
+    /**
+       \brief Configure the context using also the static features of fmls,
+       for formulas that are asserted after the setup.
+    */
+    void setup::operator()(config_mode cm, ptr_vector<expr> const & fmls) {
+        flet<ptr_vector<expr> const*> _fmls(m_formulas, &fmls);
+        (*this)(cm);
+    }
+
+    void setup::get_formulas(ptr_vector<expr> & fmls) const {
+        m_context.get_asserted_formulas(fmls);
+        if (m_formulas)
+            fmls.append(*m_formulas);
+    }
+
     void setup::setup_default() {
         if (m_logic == "QF_UF") 
             setup_QF_UF();
@@ -148,7 +163,7 @@ namespace smt {
         else {
             IF_VERBOSE(100, verbose_stream() << "(smt.collecting-features)\n";);
             ptr_vector<expr> fmls;
-            m_context.get_asserted_formulas(fmls);
+            get_formulas(fmls);
             st.collect(fmls.size(), fmls.c_ptr());
             TRACE("setup", st.display_primitive(tout););
             IF_VERBOSE(1000, st.display_primitive(verbose_stream()););
@@ -773,7 +788,7 @@ namespace smt {
         static_features    st(m_manager);
         IF_VERBOSE(100, verbose_stream() << "(smt.collecting-features)\n";);
         ptr_vector<expr> fmls;
-        m_context.get_asserted_formulas(fmls);
+        get_formulas(fmls);
         st.collect(fmls.size(), fmls.c_ptr());
         IF_VERBOSE(1000, st.display_primitive(verbose_stream()););
         bool fixnum = st.arith_k_sum_is_small() && m_params.m_arith_fixnum;
@@ -936,7 +951,7 @@ namespace smt {
     void setup::setup_unknown() {
         static_features st(m_manager);
         ptr_vector<expr> fmls;
-        m_context.get_asserted_formulas(fmls);
+        get_formulas(fmls);
         st.collect(fmls.size(), fmls.c_ptr());
         TRACE("setup", tout << "setup_unknown\n";);
         setup_arith();
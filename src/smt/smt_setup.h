@@ -44,6 +44,8 @@ namespace smt {
         smt_params &       m_params;
         symbol             m_logic;
         bool               m_already_configured;
+        ptr_vector<expr> const* m_formulas { nullptr }; // formulas that are asserted after the setup
+        void get_formulas(ptr_vector<expr> & fmls) const;
         void setup_auto_config();
         void setup_default();
         //
@@ -119,6 +121,7 @@ namespace smt {
         }
         symbol const & get_logic() const { return m_logic; }
         void operator()(config_mode cm);
+        void operator()(config_mode cm, ptr_vector<expr> const & fmls);
     };
 };
 
@@ -51,6 +51,7 @@ namespace smt {
         unsigned   m_num_core2th_eqs;
         unsigned   m_num_core2th_diseqs;
         unsigned   m_num_core2th_new_diseqs;
+        unsigned   m_num_propagations;
         void reset() {
             memset(this, 0, sizeof(*this));
         }
@@ -156,6 +157,27 @@ namespace smt {
             }
         };
 
+        // Justification for a literal whose edge is implied by the
+        // edge of an asserted atom. The path is recovered on demand.
+        class implied_edge_justification : public justification {
+            theory_diff_logic& m_super;
+            edge_id            m_bridge_edge;
+            edge_id            m_subsumed_edge;
+        public:
+            implied_edge_justification(theory_diff_logic& s, edge_id bridge, edge_id subsumed):
+                m_super(s), m_bridge_edge(bridge), m_subsumed_edge(subsumed) {}
+
+            void get_antecedents(conflict_resolution & cr) override {
+                m_super.get_implied_bound_antecedents(m_bridge_edge, m_subsumed_edge, cr);
+            }
+
+            theory_id get_from_theory() const override { return m_super.get_id(); }
+
+            proof * mk_proof(conflict_resolution & cr) override { return nullptr; }
+
+            char const * get_name() const override { return "dl-implied-edge"; }
+        };
+
         struct scope {
             unsigned      m_atoms_lim;
             unsigned      m_asserted_atoms_lim;
@@ -194,6 +216,7 @@ namespace smt {
         arith_factory *                m_factory;
         rational                       m_delta;
         nc_functor                     m_nc_functor;   
+        svector<edge_id>               m_subsumed;
 
         // For optimization purpose
         typedef vector <std::pair<theory_var, rational> > objective_term;
@@ -335,6 +358,8 @@ namespace smt {
 
         bool propagate_atom(atom* a);
 
+        void propagate_implied_edges(edge_id id);
+
         theory_var mk_term(app* n);
 
         theory_var mk_num(app* n, rational const& r);
@@ -327,6 +327,7 @@ template<typename Ext>
 void theory_diff_logic<Ext>::collect_statistics(::statistics & st) const {
     st.update("dl conflicts", m_stats.m_num_conflicts);
     st.update("dl asserts", m_stats.m_num_assertions);
+    st.update("dl propagations", m_stats.m_num_propagations);
     st.update("core->dl eqs", m_stats.m_num_core2th_eqs);
     st.update("core->dl diseqs", m_stats.m_num_core2th_diseqs);
     m_arith_eq_adapter.collect_statistics(st);
@@ -589,9 +590,41 @@ bool theory_diff_logic<Ext>::propagate_atom(atom* a) {
         
         return false;
     }
+    if (m_params.m_arith_dl_implied_edges && m_params.m_arith_bound_prop != bound_prop_mode::BP_NONE) {
+        propagate_implied_edges(edge_id);
+    }
     return true;
 }
 
+/**
+   \brief Assign the atoms whose edges are implied by the newly enabled edge \c id.
+   BP_SIMPLE only considers edges parallel to \c id, BP_REFINE also considers
+   edges that bypass \c id together with one of its adjacent edges. The latter
+   are justified lazily by a shortest path search during conflict resolution.
+   Only used when smt.arith.dl_implied_edges is set.
+*/
+template<typename Ext>
+void theory_diff_logic<Ext>::propagate_implied_edges(edge_id id) {
+    bool lazy = m_params.m_arith_bound_prop == bound_prop_mode::BP_REFINE && !m.proofs_enabled();
+    literal bridge = m_graph.get_explanation(id);
+    m_subsumed.reset();
+    if (lazy) 
+        m_graph.find_subsumed2(id, m_subsumed);
+    else 
+        m_graph.find_subsumed1(id, m_subsumed);
+    for (edge_id e : m_subsumed) {
+        literal l = m_graph.get_explanation(e);
+        if (l == null_literal || ctx.get_assignment(l) != l_undef) 
+            continue;
+        TRACE("arith", tout << "implied " << l << " by " << bridge << "\n";);
+        m_stats.m_num_propagations++;
+        if (lazy) 
+            ctx.assign(l, ctx.mk_justification(implied_edge_justification(*this, id, e)));
+        else 
+            ctx.assign(l, ctx.mk_justification(theory_propagation_justification(get_id(), ctx.get_region(), 1, &bridge, l)));
+    }
+}
+
 template<typename Ext>
 void theory_diff_logic<Ext>::new_edge(dl_var src, dl_var dst, unsigned num_edges, edge_id const* edges) {
 
@@ -283,6 +283,7 @@ class theory_lra::imp {
             m_nla->settings().horner_subs_fixed() =           prms.arith_nl_horner_subs_fixed();            
             m_nla->settings().horner_frequency() =            prms.arith_nl_horner_frequency();
             m_nla->settings().horner_row_length_limit() =     prms.arith_nl_horner_row_length_limit();
+            m_nla->settings().horner_row_cache_skips() =      prms.arith_nl_horner_row_cache_skips();
             m_nla->settings().run_grobner() =                 prms.arith_nl_grobner();
             m_nla->settings().run_nra()  =                    prms.arith_nl_nra();
             m_nla->settings().grobner_subs_fixed() =          prms.arith_nl_grobner_subs_fixed();
@@ -882,6 +883,7 @@ public:
         lp().settings().enable_hnf() = lpar.arith_enable_hnf();
         lp().settings().print_external_var_name() = lpar.arith_print_ext_var_names();
         lp().set_track_pivoted_rows(lpar.arith_bprop_on_pivoted_rows());
+        lp().settings().max_cells_for_bound_propagation = lpar.arith_bprop_max_cells();
         lp().settings().report_frequency = lpar.arith_rep_freq();
         lp().settings().print_statistics = lpar.arith_print_stats();
         lp().settings().cheap_eqs() = lpar.arith_propagate_eqs();
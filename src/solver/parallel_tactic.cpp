@@ -25,13 +25,19 @@ Notes:
   3. Cube using the parameter settings prescribed in m_params.
   4. Optionally pass the cubes as assumptions and solve each sub-cube with a prescribed resource bound.
   5. Assemble cubes that could not be solved and create a cube state.
+
+ Tasks are kept in per-thread queues; idle threads steal the oldest task of another thread.
+ Units and refuted cubes, conditioned on the cubes asserted in the task that found them,
+ are shared through a separate ast_manager and imported by other tasks before they simplify.
  
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/obj_hashtable.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
 #include "solver/solver.h"
 #include "solver/solver2tactic.h"
 #include "tactic/tactic.h"
@@ -39,6 +45,28 @@ Notes:
 #include "solver/parallel_tactic.h"
 #include "solver/parallel_params.hpp"
 
+expr_ref_vector get_base_level_units(solver& s) {
+    ast_manager& m = s.get_manager();
+    expr_ref_vector trail = s.get_trail(), units(m);
+    ptr_vector<expr> atoms;
+    for (expr* u : trail) {
+        if (!u) 
+            continue;
+        units.push_back(u);
+        expr* a = u;
+        m.is_not(u, a);
+        atoms.push_back(a);
+    }
+    unsigned_vector levels;
+    s.get_levels(atoms, levels);
+    unsigned j = 0;
+    for (unsigned i = 0; i < units.size(); ++i) 
+        if (levels[i] == 0) 
+            units.set(j++, units.get(i));
+    units.shrink(j);
+    return units;
+}
+
 #ifdef SINGLE_THREAD
 
 tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
@@ -51,6 +79,7 @@ tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
 #include <thread>
 #include <mutex>
 #include <cmath>
+#include <deque>
 #include <condition_variable>
 
 class parallel_tactic : public tactic {
@@ -59,31 +88,63 @@ class parallel_tactic : public tactic {
     class solver_state; 
 
     class task_queue {
-        std::mutex                   m_mutex;
-        std::condition_variable      m_cond;
-        ptr_vector<solver_state>     m_tasks;
-        ptr_vector<solver_state>     m_active;
-        unsigned                     m_num_waiters;
-        std::atomic<bool>            m_shutdown;
-
-        void inc_wait() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            ++m_num_waiters;
+
+        /**
+           Each worker owns a queue of tasks. The owner takes its most recent task,
+           idle workers steal the oldest task of another worker.
+        */
+        struct worker_queue {
+            std::mutex                m_mutex;
+            std::deque<solver_state*> m_tasks;
+        };
+
+        std::mutex                       m_mutex;
+        std::condition_variable          m_cond;
+        scoped_ptr_vector<worker_queue>  m_queues;
+        ptr_vector<solver_state>         m_active;
+        unsigned                         m_num_waiters;
+        unsigned                         m_num_pending;   // queued or active tasks
+        std::atomic<unsigned>            m_num_queued;
+        std::atomic<unsigned>            m_num_steals;
+        std::atomic<bool>                m_shutdown;
+
+        solver_state* pop_task(unsigned id) {
+            worker_queue& q = *m_queues[id];
+            std::lock_guard<std::mutex> lock(q.m_mutex);
+            if (q.m_tasks.empty())
+                return nullptr;
+            solver_state* st = q.m_tasks.back();
+            q.m_tasks.pop_back();
+            return st;
         }
 
-        void dec_wait() {
-            std::lock_guard<std::mutex> lock(m_mutex);
-            --m_num_waiters;
+        solver_state* steal_task(unsigned id) {
+            for (unsigned i = 1; i < m_queues.size(); ++i) {
+                worker_queue& q = *m_queues[(id + i) % m_queues.size()];
+                std::lock_guard<std::mutex> lock(q.m_mutex);
+                if (!q.m_tasks.empty()) {
+                    solver_state* st = q.m_tasks.front();
+                    q.m_tasks.pop_front();
+                    ++m_num_steals;
+                    return st;
+                }
+            }
+            return nullptr;
         }
 
-        solver_state* try_get_task() {
-            solver_state* st = nullptr;
+        solver_state* try_get_task(unsigned id) {
+            if (m_num_queued == 0)
+                return nullptr;
+            solver_state* st = pop_task(id);
+            if (!st)
+                st = steal_task(id);
+            if (!st)
+                return nullptr;
+            --m_num_queued;
             std::lock_guard<std::mutex> lock(m_mutex);
-            if (!m_tasks.empty()) {
-                st = m_tasks.back();
-                m_tasks.pop_back();
-                m_active.push_back(st);
-            }
+            m_active.push_back(st);
+            if (m_shutdown)
+                st->m().limit().cancel();
             return st;
         }
 
@@ -91,15 +152,25 @@ class parallel_tactic : public tactic {
 
         task_queue(): 
             m_num_waiters(0), 
+            m_num_pending(0),
+            m_num_queued(0),
+            m_num_steals(0),
             m_shutdown(false) {}             
 
         ~task_queue() { reset(); }
 
+        void init(unsigned num_workers) {
+            reset();
+            m_queues.reset();
+            for (unsigned i = 0; i < num_workers; ++i)
+                m_queues.push_back(alloc(worker_queue));
+        }
+
         void shutdown() {
             if (!m_shutdown) {
                 m_shutdown = true;
-                m_cond.notify_all();
                 std::lock_guard<std::mutex> lock(m_mutex);
+                m_cond.notify_all();
                 for (solver_state* st : m_active) {
                     st->m().limit().cancel();
                 }
@@ -108,9 +179,17 @@ class parallel_tactic : public tactic {
 
         bool in_shutdown() const { return m_shutdown; }
 
-        void add_task(solver_state* task) {
+        unsigned num_steals() const { return m_num_steals; }
+
+        void add_task(solver_state* task, unsigned id) {
+            ++m_num_queued;
+            {
+                worker_queue& q = *m_queues[id];
+                std::lock_guard<std::mutex> lock(q.m_mutex);
+                q.m_tasks.push_back(task);
+            }
             std::lock_guard<std::mutex> lock(m_mutex);
-            m_tasks.push_back(task);
+            ++m_num_pending;
             if (m_num_waiters > 0) {
                 m_cond.notify_one();
             }            
@@ -118,22 +197,18 @@ class parallel_tactic : public tactic {
 
         bool is_idle() {
             std::lock_guard<std::mutex> lock(m_mutex);
-            return m_tasks.empty() && m_num_waiters > 0;
+            return m_num_queued == 0 && m_num_waiters > 0;
         }
 
-        solver_state* get_task() { 
+        solver_state* get_task(unsigned id) { 
             while (!m_shutdown) {
-                inc_wait();
-                solver_state* st = try_get_task();
-                if (st) {
-                    dec_wait();
+                solver_state* st = try_get_task(id);
+                if (st) 
                     return st;
-                }
-                {
-                    std::unique_lock<std::mutex> lock(m_mutex);
-                    m_cond.wait(lock);
-                }
-                dec_wait();
+                std::unique_lock<std::mutex> lock(m_mutex);
+                ++m_num_waiters;
+                m_cond.wait(lock, [&]() { return m_shutdown || m_num_queued > 0; });
+                --m_num_waiters;
             }
             return nullptr;
         }
@@ -141,35 +216,45 @@ class parallel_tactic : public tactic {
         void task_done(solver_state* st) {
             std::lock_guard<std::mutex> lock(m_mutex);
             m_active.erase(st);
-            if (m_tasks.empty() && m_active.empty()) {
+            SASSERT(m_num_pending > 0);
+            if (--m_num_pending == 0) {
                 m_shutdown = true;
                 m_cond.notify_all();
             }
         }
 
         void stats(::statistics& st) {
-            for (auto* t : m_tasks) 
-                t->get_solver().collect_statistics(st);
+            for (worker_queue* q : m_queues) 
+                for (auto* t : q->m_tasks) 
+                    t->get_solver().collect_statistics(st);
             for (auto* t : m_active) 
                 t->get_solver().collect_statistics(st);
         }
 
         void reset() {
-            for (auto* t : m_tasks) 
-                dealloc(t);
+            for (worker_queue* q : m_queues) {
+                for (auto* t : q->m_tasks) 
+                    dealloc(t);
+                q->m_tasks.clear();
+            }
             for (auto* t : m_active) 
                 dealloc(t);
-            m_tasks.reset();
             m_active.reset();
             m_num_waiters = 0;
+            m_num_pending = 0;
+            m_num_queued = 0;
+            m_num_steals = 0;
             m_shutdown = false;
         }
 
         std::ostream& display(std::ostream& out) {
             std::lock_guard<std::mutex> lock(m_mutex);
-            out << "num_tasks " << m_tasks.size() << " active: " << m_active.size() << "\n";
-            for (solver_state* st : m_tasks) {
-                st->display(out);
+            out << "num_tasks " << m_num_queued << " active: " << m_active.size() << " steals: " << m_num_steals << "\n";
+            for (worker_queue* q : m_queues) {
+                std::lock_guard<std::mutex> qlock(q->m_mutex);
+                for (solver_state* st : q->m_tasks) {
+                    st->display(out);
+                }
             }
             return out;
         }
@@ -203,6 +288,8 @@ class parallel_tactic : public tactic {
         unsigned        m_depth;                  // number of nested calls to cubing
         double          m_width;                  // estimate of fraction of problem handled by state
         bool            m_giveup;
+        unsigned        m_shared_index;           // number of shared lemmas imported
+        unsigned_vector m_exported;               // indices of shared lemmas exported by this task and not yet imported
 
     public:
         solver_state(ast_manager* m, solver* s, params_ref const& p): 
@@ -213,7 +300,8 @@ class parallel_tactic : public tactic {
             m_solver(s),
             m_depth(0),
             m_width(1.0),
-            m_giveup(false)
+            m_giveup(false),
+            m_shared_index(0)
         {
         }
 
@@ -231,6 +319,16 @@ class parallel_tactic : public tactic {
         
         bool has_assumptions() const { return !m_assumptions.empty(); }
 
+        expr_ref_vector const& asserted_cubes() const { return m_asserted_cubes; }
+
+        unsigned shared_index() const { return m_shared_index; }
+
+        void set_shared_index(unsigned i) { m_shared_index = i; m_exported.reset(); }
+
+        void add_exported(unsigned i) { m_exported.push_back(i); }
+
+        bool is_exported(unsigned i) const { return m_exported.contains(i); }
+
         solver_state* clone() {
             SASSERT(!m_cubes.empty());
             ast_manager& m = m_solver->get_manager();
@@ -243,6 +341,7 @@ class parallel_tactic : public tactic {
             for (expr* c : m_assumptions) st->m_assumptions.push_back(tr(c));
             st->m_depth = m_depth;
             st->m_width = m_width;
+            st->m_shared_index = m_shared_index;
             return st;
         }
 
@@ -372,6 +471,16 @@ private:
     unsigned      m_last_depth;
     int           m_exn_code;
     std::string   m_exn_msg;
+    unsigned      m_share_max_size;
+    scoped_ptr<ast_manager>     m_share_manager;  // manager of lemmas shared between tasks
+    scoped_ptr<expr_ref_vector> m_shared;         // shared units and conflict clauses
+    scoped_ptr<func_decl_ref_vector> m_input_decl_refs;
+    obj_hashtable<expr>         m_shared_set;
+    obj_hashtable<func_decl>    m_input_decls;    // uninterpreted symbols of the input
+    unsigned      m_num_steals;
+    unsigned      m_num_shared_units;
+    unsigned      m_num_shared_conflicts;
+    unsigned      m_num_imported;
 
     void init() {
         parallel_params pp(m_params);
@@ -384,7 +493,12 @@ private:
         m_last_depth = 0;
         m_backtrack_frequency = pp.conquer_backtrack_frequency();
         m_conquer_delay = pp.conquer_delay();
+        m_share_max_size = pp.share_max_size();
         m_exn_code = 0;
+        m_num_steals = 0;
+        m_num_shared_units = 0;
+        m_num_shared_conflicts = 0;
+        m_num_imported = 0;
         m_params.set_bool("override_incremental", true);
         m_core.reset();
     }
@@ -476,7 +590,126 @@ private:
         close_branch(s, l_undef);
     }
 
-    void cube_and_conquer(solver_state& s) {
+    struct input_symbol_proc {
+        obj_hashtable<func_decl> const& m_decls;
+        bool m_ok { true };
+        input_symbol_proc(obj_hashtable<func_decl> const& decls): m_decls(decls) {}
+        void operator()(app* a) { 
+            if (a->get_family_id() == null_family_id && !m_decls.contains(a->get_decl())) 
+                m_ok = false; 
+        }
+        void operator()(var*) {}
+        void operator()(quantifier*) { m_ok = false; }
+    };
+
+    struct collect_input_decls {
+        ast_translation&          m_tr;
+        func_decl_ref_vector&     m_decls;
+        obj_hashtable<func_decl>& m_set;
+        collect_input_decls(ast_translation& tr, func_decl_ref_vector& decls, obj_hashtable<func_decl>& set): 
+            m_tr(tr), m_decls(decls), m_set(set) {}
+        void operator()(app* a) { 
+            if (a->get_family_id() != null_family_id)
+                return;
+            func_decl* f = m_tr(a->get_decl());
+            if (!m_set.contains(f)) {
+                m_decls.push_back(f);
+                m_set.insert(f);
+            }
+        }
+        void operator()(var*) {}
+        void operator()(quantifier*) {}
+    };
+
+    void reset_sharing() {
+        m_shared_set.reset();
+        m_input_decls.reset();
+        m_shared = nullptr;
+        m_input_decl_refs = nullptr;
+        m_share_manager = nullptr;
+    }
+
+    void init_sharing(expr_ref_vector const& clauses) {
+        reset_sharing();
+        ast_manager& m = clauses.get_manager();
+        m_share_manager = alloc(ast_manager, m, true);
+        m_shared = alloc(expr_ref_vector, *m_share_manager);
+        m_input_decl_refs = alloc(func_decl_ref_vector, *m_share_manager);
+        if (m_share_max_size == 0)
+            return;
+        ast_translation tr(m, *m_share_manager);
+        collect_input_decls proc(tr, *m_input_decl_refs, m_input_decls);
+        for_each_expr(proc, clauses);
+    }
+
+    /**
+       \brief share the clause (lits | ~asserted_cubes) learned by a task. 
+       Only clauses over uninterpreted symbols of the input are shared, since fresh symbols 
+       created in different tasks can have the same name.
+    */
+    void share_lemma(solver_state& s, expr_ref_vector const& lits, unsigned& num_shared) {
+        ast_manager& m = s.m();
+        if (m_share_max_size == 0 || lits.size() + s.asserted_cubes().size() > m_share_max_size)
+            return;
+        expr_ref_vector clause(lits);
+        for (expr* c : s.asserted_cubes()) 
+            clause.push_back(mk_not(m, c));
+        expr_ref fml(mk_or(clause), m);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ast_translation tr(m, *m_share_manager);
+        expr_ref f(tr(fml.get()), *m_share_manager);
+        if (m_share_manager->is_true(f) || m_shared_set.contains(f))
+            return;
+        input_symbol_proc proc(m_input_decls);
+        for_each_expr(proc, f.get());
+        if (!proc.m_ok)
+            return;
+        s.add_exported(m_shared->size());
+        m_shared->push_back(f);
+        m_shared_set.insert(f);
+        ++num_shared;
+    }
+
+    void share_units(solver_state& s) {
+        if (m_share_max_size <= s.asserted_cubes().size() || s.has_assumptions())
+            return;
+        expr_ref_vector units = get_base_level_units(s.get_solver());
+        expr_ref_vector lits(s.m());
+        for (expr* u : units) {
+            if (s.asserted_cubes().contains(u)) 
+                continue;
+            lits.reset();
+            lits.push_back(u);
+            share_lemma(s, lits, m_num_shared_units);
+        }
+    }
+
+    void share_conflict(solver_state& s, expr_ref_vector const& cube) {
+        expr_ref_vector lits(s.m());
+        for (expr* c : cube)
+            lits.push_back(mk_not(s.m(), c));
+        share_lemma(s, lits, m_num_shared_conflicts);
+    }
+
+    void import_lemmas(solver_state& s) {
+        expr_ref_vector lemmas(s.m());
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (s.shared_index() == m_shared->size())
+                return;
+            ast_translation tr(*m_share_manager, s.m());
+            // skip the lemmas exported by s itself.
+            for (unsigned i = s.shared_index(); i < m_shared->size(); ++i)
+                if (!s.is_exported(i))
+                    lemmas.push_back(tr(m_shared->get(i)));
+            m_num_imported += lemmas.size();
+            s.set_shared_index(m_shared->size());
+        }
+        IF_VERBOSE(2, verbose_stream() << "(tactic.parallel :import " << lemmas.size() << ")\n";);
+        s.get_solver().assert_expr(lemmas);
+    }
+
+    void cube_and_conquer(solver_state& s, unsigned id) {
         ast_manager& m = s.m();
         vector<cube_var> cube, hard_cubes, cubes;
         expr_ref_vector vars(m);
@@ -489,7 +722,7 @@ private:
         cube.append(s.split_cubes(1));
         SASSERT(cube.size() <= 1);
         IF_VERBOSE(2, verbose_stream() << "(tactic.parallel :split-cube " << cube.size() << ")\n";);
-        if (!s.cubes().empty()) m_queue.add_task(s.clone());
+        if (!s.cubes().empty()) m_queue.add_task(s.clone(), id);
         if (!cube.empty()) {
             s.assert_cube(cube.get(0).cube());
             vars.reset();
@@ -502,8 +735,9 @@ private:
         // simplify
         s.inc_depth(1);
         if (canceled(s)) return;
+        import_lemmas(s);
         switch (s.simplify()) {
-        case l_undef: break;
+        case l_undef: share_units(s); break;
         case l_true:  report_sat(s, nullptr); return;
         case l_false: report_unsat(s); return;                
         }
@@ -550,6 +784,7 @@ private:
                     IF_VERBOSE(0, verbose_stream() << "(tactic.parallel :backtrack " << cutoff << " -> " << c.size() << ")\n");
                     cutoff = c.size();
                 }
+                share_conflict(s, c);
                 inc_unsat(s);
                 log_branches(l_false);
                 break;
@@ -570,7 +805,7 @@ private:
 
             }
             if (cubes.size() >= conquer_batch_size()) {
-                spawn_cubes(s, 10*width, cubes);
+                spawn_cubes(s, id, 10*width, cubes);
                 first = false;
                 cubes.reset();
             }
@@ -594,13 +829,13 @@ private:
         }                
     }
 
-    void spawn_cubes(solver_state& s, unsigned width, vector<cube_var>& cubes) {
+    void spawn_cubes(solver_state& s, unsigned id, unsigned width, vector<cube_var>& cubes) {
         if (cubes.empty()) return;
         add_branches(cubes.size());
         s.set_cubes(cubes);
         solver_state* s1 = s.clone();
         s1->inc_width(width);
-        m_queue.add_task(s1);
+        m_queue.add_task(s1, id);
     }
 
     /*
@@ -652,10 +887,10 @@ private:
         return memory::above_high_watermark();
     }
 
-    void run_solver() {
+    void run_solver(unsigned id) {
         try {
-            while (solver_state* st = m_queue.get_task()) {
-                cube_and_conquer(*st);                
+            while (solver_state* st = m_queue.get_task(id)) {
+                cube_and_conquer(*st, id);                
                 collect_statistics(*st);
                 m_queue.task_done(st);
                 if (!st->m().inc()) m_queue.shutdown();
@@ -691,10 +926,11 @@ private:
         add_branches(1);
         vector<std::thread> threads;
         for (unsigned i = 0; i < m_num_threads; ++i) 
-            threads.push_back(std::thread([this]() { run_solver(); }));
+            threads.push_back(std::thread([this, i]() { run_solver(i); }));
         for (std::thread& t : threads) 
             t.join();
         m_queue.stats(m_stats);
+        m_num_steals += m_queue.num_steals();
         m_manager.limit().reset_cancel();
         if (m_exn_code == -1) 
             throw default_exception(std::move(m_exn_msg));
@@ -744,7 +980,8 @@ public:
             throw default_exception("parallel tactic does not work with trace");
         solver* s = m_solver->translate(m, m_params);
         solver_state* st = alloc(solver_state, nullptr, s, m_params);
-        m_queue.add_task(st);
+        m_queue.init(std::max(1u, m_num_threads));
+        m_queue.add_task(st, 0);
         expr_ref_vector clauses(m);
         ptr_vector<expr> assumptions;
         obj_map<expr, expr*> bool2dep;
@@ -755,6 +992,7 @@ public:
         for (expr * clause : clauses) {
             s->assert_expr(clause);
         }
+        init_sharing(clauses);
         st->set_assumptions(assumptions);
         model_ref mdl;
         lbool is_sat = solve(mdl);
@@ -789,6 +1027,7 @@ public:
     void cleanup() override {
         m_queue.reset();
         m_models.reset();
+        reset_sharing();
     }
 
     tactic* translate(ast_manager& m) override {
@@ -800,6 +1039,7 @@ public:
         m_params.copy(p);
         parallel_params pp(p);
         m_conquer_delay = pp.conquer_delay();
+        m_share_max_size = pp.share_max_size();
     }
 
     void collect_statistics(statistics & st) const override {
@@ -807,6 +1047,10 @@ public:
         st.update("par unsat", m_num_unsat);
         st.update("par models", m_models.size());
         st.update("par progress", m_progress);
+        st.update("par steals", m_num_steals);
+        st.update("par shared units", m_num_shared_units);
+        st.update("par shared conflicts", m_num_shared_conflicts);
+        st.update("par imported lemmas", m_num_imported);
     }
 
     void reset_statistics() override {
@@ -814,7 +1058,6 @@ public:
     }
 };
 
-
 tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
     return alloc(parallel_tactic, s, p);
 }
@@ -18,8 +18,17 @@ Notes:
 --*/
 #pragma once
 
+#include "ast/ast.h"
+
 class tactic;
 class solver;
 
 tactic * mk_parallel_tactic(solver* s, params_ref const& p);
 
+/**
+   \brief Return the literals on the trail of s that are assigned at the base level.
+   The trail can contain decisions and their consequences when check_sat stopped
+   on a restart or conflict limit, and those are not implied by the assertions of s.
+*/
+expr_ref_vector get_base_level_units(solver& s);
+
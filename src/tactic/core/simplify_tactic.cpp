@@ -19,16 +19,38 @@ Notes:
 #include "tactic/core/simplify_tactic.h"
 #include "ast/rewriter/th_rewriter.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_translation.h"
+#include "ast/for_each_expr.h"
+#include "util/union_find.h"
+#include "util/scoped_ptr_vector.h"
+#include "params/rewriter_params.hpp"
+#include "tactic/tactic_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#endif
 
 struct simplify_tactic::imp {
     ast_manager &   m_manager;
     th_rewriter     m_r;
     unsigned        m_num_steps;
+    params_ref      m_params;
+    unsigned        m_num_threads;
+    unsigned        m_min_parallel_size;
 
     imp(ast_manager & m, params_ref const & p):
         m_manager(m),
         m_r(m, p),
         m_num_steps(0) {
+        updt_params(p);
+    }
+
+    void updt_params(params_ref const & p) {
+        tactic_params tp(p);
+        m_params            = p;
+        m_num_threads       = tp.simplify_threads();
+        m_min_parallel_size = tp.simplify_min_parallel_size();
+        m_r.updt_params(p);
     }
 
     ~imp() {
@@ -47,6 +69,10 @@ struct simplify_tactic::imp {
         m_num_steps = 0;
         if (g.inconsistent())
             return;
+        if (use_threads(g) && parallel_simplify(g)) {
+            g.elim_redundancies();
+            return;
+        }
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
         unsigned size = g.size();
@@ -68,6 +94,158 @@ struct simplify_tactic::imp {
     }
 
     unsigned get_num_steps() const { return m_num_steps; }
+
+    bool use_threads(goal const & g) const {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        return m_num_threads > 1 && g.size() >= m_min_parallel_size && !g.proofs_enabled() && !m().has_trace_stream();
+#endif
+    }
+
+    /**
+       \brief Partition the formulas of g into at most n parts.
+       Formulas that share a sub-term other than a constant, value or variable are placed in the same
+       part, so that the rewriter cache of each part sees all occurrences of its shared sub-terms.
+       Constants are too common to separate formulas, and rewriting them is cheap in every part.
+       Connected formulas are packed greedily into the part with the fewest expressions.
+    */
+    void partition(goal const & g, unsigned n, vector<unsigned_vector> & parts) {
+        unsigned sz = g.size();
+        basic_union_find uf;
+        for (unsigned i = 0; i < sz; ++i)
+            uf.mk_var();
+        unsigned_vector owner(m().get_expr_id_range(), UINT_MAX);
+        unsigned_vector weight(sz, 0u);
+        ptr_vector<expr> todo;
+        for (unsigned i = 0; i < sz; ++i) {
+            todo.push_back(g.form(i));
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                todo.pop_back();
+                unsigned id = e->get_id();
+                if (id >= owner.size())
+                    owner.resize(id + 1, UINT_MAX);
+                if (owner[id] != UINT_MAX) {
+                    if (owner[id] != i && !is_var(e) && !m().is_value(e) && !(is_app(e) && to_app(e)->get_num_args() == 0))
+                        uf.merge(owner[id], i);
+                    continue;
+                }
+                owner[id] = i;
+                weight[i]++;
+                if (is_app(e))
+                    todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                else if (is_quantifier(e))
+                    todo.push_back(to_quantifier(e)->get_expr());
+            }
+        }
+        // collect components and their weights
+        unsigned_vector comp_weight(sz, 0u);
+        unsigned_vector roots;
+        for (unsigned i = 0; i < sz; ++i) {
+            unsigned r = uf.find(i);
+            if (comp_weight[r] == 0)
+                roots.push_back(r);
+            comp_weight[r] += weight[i] + 1;
+        }
+        std::sort(roots.begin(), roots.end(), [&](unsigned a, unsigned b) { return comp_weight[a] > comp_weight[b]; });
+        n = std::min(n, roots.size());
+        parts.reset();
+        parts.resize(n);
+        unsigned_vector part_weight(n, 0u), part_of(sz, UINT_MAX);
+        for (unsigned r : roots) {
+            unsigned best = 0;
+            for (unsigned j = 1; j < n; ++j)
+                if (part_weight[j] < part_weight[best])
+                    best = j;
+            part_weight[best] += comp_weight[r];
+            part_of[r] = best;
+        }
+        for (unsigned i = 0; i < sz; ++i)
+            parts[part_of[uf.find(i)]].push_back(i);
+    }
+
+#ifdef SINGLE_THREAD
+    bool parallel_simplify(goal & g) {
+        UNREACHABLE();
+        return false;
+    }
+#else
+    /**
+       \brief Simplify the parts of g concurrently, each in its own manager.
+       Formulas are translated into the worker managers and back by this thread,
+       the workers only rewrite.
+       Return false, without changing g, if the formulas of g form a single part.
+    */
+    bool parallel_simplify(goal & g) {
+        vector<unsigned_vector> parts;
+        partition(g, m_num_threads, parts);
+        unsigned n = parts.size();
+        if (n <= 1)
+            return false;
+        IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(simplifier :formulas " << g.size() << " :parts " << n << ")\n";);
+        scoped_ptr_vector<ast_manager>     managers;
+        scoped_ptr_vector<expr_ref_vector> fmls;
+        scoped_limits scl(m().limit());
+        for (unsigned i = 0; i < n; ++i) {
+            ast_manager * new_m = alloc(ast_manager, m(), true);
+            managers.push_back(new_m);
+            scl.push_child(&new_m->limit());
+            fmls.push_back(alloc(expr_ref_vector, *new_m));
+            ast_translation tr(m(), *new_m);
+            for (unsigned idx : parts[i])
+                fmls[i]->push_back(tr(g.form(idx)));
+        }
+
+        unsigned_vector steps(n, 0u);
+        bool failed = false;
+        std::string ex_msg;
+        std::mutex mux;
+        auto worker = [&](unsigned i) {
+            try {
+                ast_manager & new_m = *managers[i];
+                th_rewriter rw(new_m, m_params);
+                expr_ref new_curr(new_m);
+                expr_ref_vector & fs = *fmls[i];
+                for (unsigned j = 0; j < fs.size(); ++j) {
+                    rw(fs.get(j), new_curr);
+                    steps[i] += rw.get_num_steps();
+                    fs[j] = new_curr;
+                }
+            }
+            catch (z3_exception & ex) {
+                std::lock_guard<std::mutex> lock(mux);
+                if (!failed) {
+                    failed = true;
+                    ex_msg = ex.msg();
+                }
+                for (unsigned j = 0; j < n; ++j)
+                    managers[j]->limit().cancel();
+            }
+        };
+        vector<std::thread> threads(n);
+        for (unsigned i = 0; i < n; ++i)
+            threads[i] = std::thread([&, i]() { worker(i); });
+        for (unsigned i = 0; i < n; ++i)
+            threads[i].join();
+        if (failed)
+            throw rewriter_exception(std::move(ex_msg));
+
+        for (unsigned i = 0; i < n && !g.inconsistent(); ++i) {
+            m_num_steps += steps[i];
+            ast_translation tr(*managers[i], m());
+            unsigned j = 0;
+            for (unsigned idx : parts[i]) {
+                if (g.inconsistent())
+                    break;
+                expr_ref new_curr(tr(fmls[i]->get(j++)), m());
+                g.update(idx, new_curr, nullptr, g.dep(idx));
+            }
+        }
+        TRACE("simplifier", g.display(tout););
+        return true;
+    }
+#endif
 };
 
 simplify_tactic::simplify_tactic(ast_manager & m, params_ref const & p):
@@ -81,11 +259,13 @@ simplify_tactic::~simplify_tactic() {
 
 void simplify_tactic::updt_params(params_ref const & p) {
     m_params = p;
-    m_imp->m_r.updt_params(p);
+    m_imp->updt_params(p);
 }
 
 void simplify_tactic::get_param_descrs(param_descrs & r) {
     th_rewriter::get_param_descrs(r);
+    r.insert("simplify.threads", CPK_UINT, "(default: 1) number of threads used by the simplifier.");
+    r.insert("simplify.min_parallel_size", CPK_UINT, "(default: 10000) minimal number of formulas in a goal for the simplifier to use threads.");
 }
 
 void simplify_tactic::operator()(goal_ref const & in, 
@@ -102,12 +282,22 @@ void simplify_tactic::operator()(goal_ref const & in,
 
 
 void simplify_tactic::cleanup() {
+    rewriter_params rp(m_params);
+    if (rp.cache_persistent()) {
+        // keep the rewriter cache for the next goal
+        m_imp->reset();
+        return;
+    }
     ast_manager & m = m_imp->m();
     params_ref p = std::move(m_params);
     m_imp->~imp();
     new (m_imp) imp(m, p);
 }
 
+void simplify_tactic::collect_statistics(statistics & st) const {
+    m_imp->m_r.collect_statistics(st);
+}
+
 unsigned simplify_tactic::get_num_steps() const {
     return m_imp->get_num_steps();
 }
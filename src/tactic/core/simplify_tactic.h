@@ -39,6 +39,8 @@ public:
     
     void cleanup() override;
 
+    void collect_statistics(statistics & st) const override;
+
     unsigned get_num_steps() const;
 
     tactic * translate(ast_manager & m) override { return alloc(simplify_tactic, m, m_params); }
@@ -46,6 +46,11 @@ class solve_eqs_tactic : public tactic {
         bool                          m_context_solve;
         scoped_ptr<expr_substitution> m_subst;
         scoped_ptr<expr_substitution> m_norm_subst;
+        scoped_ptr<expr_substitution> m_plain_subst;  // m_norm_subst without dependencies, used when cores are enabled
+        obj_map<expr, expr_dependency*> m_subst_deps; // dependencies of eliminated variables occurring in a term
+        expr_ref_vector               m_subst_deps_keys;
+        expr_dependency_ref_vector    m_subst_deps_pinned;
+        obj_map<expr, unsigned>       m_arg_occs;     // occurrences of constants in the arguments of an equation
         expr_sparse_mark              m_candidate_vars;
         expr_sparse_mark              m_candidate_set;
         ptr_vector<expr>              m_candidates;
@@ -64,6 +69,8 @@ class solve_eqs_tactic : public tactic {
             m_a_util(m),
             m_num_steps(0),
             m_num_eliminated_vars(0),
+            m_subst_deps_keys(m),
+            m_subst_deps_pinned(m),
             m_marked_candidates(m) {
             updt_params(p);
             if (m_r == nullptr)
@@ -258,6 +265,39 @@ class solve_eqs_tactic : public tactic {
             return false;
         }
         
+        /**
+           \brief Count for each uninterpreted constant the number of arguments of lhs, and rhs, it occurs in.
+           A constant with count 1 that occurs in the i-th argument of lhs occurs neither in rhs 
+           nor in the other arguments, so a single pass replaces an occurs check per argument.
+        */
+        void collect_arg_occs(app * lhs, expr * rhs) {
+            m_arg_occs.reset();
+            ptr_buffer<expr> todo;
+            unsigned num = lhs->get_num_args();
+            for (unsigned i = 0; i <= num; ++i) {
+                expr_fast_mark1 visited;
+                todo.push_back(i < num ? lhs->get_arg(i) : rhs);
+                while (!todo.empty()) {
+                    expr * e = todo.back();
+                    todo.pop_back();
+                    if (visited.is_marked(e))
+                        continue;
+                    visited.mark(e);
+                    if (is_uninterp_const(e))
+                        m_arg_occs.insert_if_not_there(e, 0)++;
+                    else if (is_app(e))
+                        todo.append(to_app(e)->get_num_args(), to_app(e)->get_args());
+                    else if (is_quantifier(e))
+                        todo.push_back(to_quantifier(e)->get_expr());
+                }
+            }
+        }
+
+        bool occurs_once(expr * v) const {
+            unsigned n = 0;
+            return m_arg_occs.find(v, n) && n == 1;
+        }
+
         bool solve_arith_core(app * lhs, expr * rhs, expr * eq, app_ref & var, expr_ref & def, proof_ref & pr) {
             SASSERT(m_a_util.is_add(lhs));
             bool is_int  = m_a_util.is_int(lhs);
@@ -266,9 +306,10 @@ class solve_eqs_tactic : public tactic {
             rational a_val;
             unsigned num = lhs->get_num_args();
             unsigned i;
+            collect_arg_occs(lhs, rhs);
             for (i = 0; i < num; i++) {
                 expr * arg = lhs->get_arg(i);
-                if (is_uninterp_const(arg) && !m_candidate_vars.is_marked(arg) && check_occs(arg) && !occurs(arg, rhs) && !occurs_except(arg, lhs, i)) {
+                if (is_uninterp_const(arg) && !m_candidate_vars.is_marked(arg) && check_occs(arg) && occurs_once(arg)) {
                     a_val = rational(1); 
                     v     = arg;
                     break;
@@ -280,8 +321,7 @@ class solve_eqs_tactic : public tactic {
                          !a_val.is_zero() &&
                          (!is_int || a_val.is_minus_one()) &&
                          check_occs(v) &&
-                         !occurs(v, rhs) && 
-                         !occurs_except(v, lhs, i)) {
+                         occurs_once(v)) {
                     break;
                 }
             }
@@ -860,9 +900,81 @@ class solve_eqs_tactic : public tactic {
             m_candidate_vars.reset();
         }
         
+        /**
+           \brief The substitution applied by m_r. 
+           With unsat cores the rewriter cache is flushed after every call that uses a 
+           substitution with dependencies, which makes normalization quadratic on long 
+           chains of definitions. Instead, m_r applies the substitution without dependencies
+           and the dependencies are computed separately by get_subst_deps.
+        */
+        expr_substitution * rewrite_subst() {
+            return m_produce_unsat_cores ? m_plain_subst.get() : m_norm_subst.get();
+        }
+
+        void reset_subst_deps() {
+            m_subst_deps.reset();
+            m_subst_deps_keys.reset();
+            m_subst_deps_pinned.reset();
+        }
+
+        /**
+           \brief Return the join of the dependencies of the eliminated variables occurring in t.
+           Results are cached for all sub-terms, so the dependencies of all definitions and
+           formulas are computed in a single pass over the DAG.
+        */
+        expr_dependency * get_subst_deps(expr * t) {
+            expr_dependency * r = nullptr;
+            if (m_subst_deps.find(t, r))
+                return r;
+            ptr_buffer<expr> todo;
+            todo.push_back(t);
+            while (!todo.empty()) {
+                expr * e = todo.back();
+                if (m_subst_deps.contains(e)) {
+                    todo.pop_back();
+                    continue;
+                }
+                unsigned sz = todo.size();
+                if (is_app(e)) {
+                    for (expr * arg : *to_app(e))
+                        if (!m_subst_deps.contains(arg))
+                            todo.push_back(arg);
+                }
+                else if (is_quantifier(e) && !m_subst_deps.contains(to_quantifier(e)->get_expr())) {
+                    todo.push_back(to_quantifier(e)->get_expr());
+                }
+                if (sz < todo.size())
+                    continue;
+                todo.pop_back();
+                r = nullptr;
+                expr_dependency * d = nullptr;
+                if (is_app(e)) {
+                    for (expr * arg : *to_app(e)) {
+                        d = m_subst_deps[arg];
+                        if (d && d != r)
+                            r = m().mk_join(r, d);
+                    }
+                    expr * def = nullptr;
+                    proof * pr = nullptr;
+                    if (is_uninterp_const(e) && m_norm_subst->find(e, def, pr, d))
+                        r = m().mk_join(r, d);
+                }
+                else if (is_quantifier(e)) {
+                    r = m_subst_deps[to_quantifier(e)->get_expr()];
+                }
+                m_subst_deps_keys.push_back(e);
+                m_subst_deps_pinned.push_back(r);
+                m_subst_deps.insert(e, r);
+            }
+            return m_subst_deps[t];
+        }
+
         void normalize() {
             m_norm_subst->reset();
-            m_r->set_substitution(m_norm_subst.get());
+            if (m_produce_unsat_cores)
+                m_plain_subst->reset();
+            reset_subst_deps();
+            m_r->set_substitution(rewrite_subst());
             
 
             expr_dependency_ref new_dep(m());
@@ -879,6 +991,11 @@ class solve_eqs_tactic : public tactic {
                 m_num_steps += m_r->get_num_steps() + 1;
                 if (m_produce_proofs)
                     new_pr = m().mk_transitivity(pr, new_pr);
+                if (m_produce_unsat_cores) {
+                    SASSERT(!new_dep);
+                    new_dep = get_subst_deps(def);
+                    m_plain_subst->insert(v, new_def, new_pr);
+                }
                 new_dep = m().mk_join(dep, new_dep);
                 m_norm_subst->insert(v, new_def, new_pr, new_dep);
                 // we updated the substituting, but we don't need to reset m_r
@@ -898,7 +1015,7 @@ class solve_eqs_tactic : public tactic {
 
         void substitute(goal & g) {
             // force the cache of m_r to be reset.
-            m_r->set_substitution(m_norm_subst.get());
+            m_r->set_substitution(rewrite_subst());
             
             expr_ref new_f(m());
             proof_ref new_pr(m());
@@ -926,12 +1043,13 @@ class solve_eqs_tactic : public tactic {
                 if (m_produce_proofs)
                     new_pr = m().mk_modus_ponens(g.pr(idx), new_pr);
                 if (m_produce_unsat_cores)
-                    new_dep = m().mk_join(g.dep(idx), new_dep);
+                    new_dep = m().mk_join(g.dep(idx), get_subst_deps(f));
                 
                 g.update(idx, new_f, new_pr, new_dep);
                 if (g.inconsistent())
                     return;
             }
+            reset_subst_deps();
             g.elim_true();
             TRACE("solve_eqs", g.display(tout << "after applying substitution\n"););
 #if 0
@@ -1019,6 +1137,7 @@ class solve_eqs_tactic : public tactic {
             if (!g->inconsistent()) {
                 m_subst      = alloc(expr_substitution, m(), m_produce_unsat_cores, m_produce_proofs);
                 m_norm_subst = alloc(expr_substitution, m(), m_produce_unsat_cores, m_produce_proofs);
+                m_plain_subst = alloc(expr_substitution, m(), false, m_produce_proofs);
                 unsigned rounds = 0;
                 while (rounds < 20) {
                     ++rounds;
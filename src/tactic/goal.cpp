@@ -287,6 +287,10 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    // formulas are stored in persistent arrays shared with copies of this goal. 
+    // Leave them untouched if nothing changed, so the sharing is preserved.
+    if (f == form(i) && pr == this->pr(i) && (!unsat_core_enabled() || d == dep(i)))
+        return;
     if (proofs_enabled()) {
         SASSERT(pr);
         if (!pr)
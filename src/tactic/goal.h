@@ -123,6 +123,7 @@ public:
     proof * pr(unsigned i) const { return m().size(m_proofs) > i ? static_cast<proof*>(m().get(m_proofs, i)) : nullptr; }
     expr_dependency * dep(unsigned i) const { return unsat_core_enabled() ? m().get(m_dependencies, i) : nullptr; }
 
+    // Replace the i-th formula. It is a no-op if f, pr and dep are the ones already stored.
     void update(unsigned i, expr * f, proof * pr = nullptr, expr_dependency * dep = nullptr);
 
     void get_formulas(ptr_vector<expr> & result) const;
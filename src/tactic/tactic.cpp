@@ -20,6 +20,7 @@ Notes:
 #include "tactic/tactic.h"
 #include "tactic/probe.h"
 #include "util/stopwatch.h"
+#include "tactic/tactic_params.hpp"
 #include "model/model_v2_pp.h"
 
 
@@ -56,7 +57,8 @@ struct tactic_report::imp {
     }
 };
 
-tactic_report::tactic_report(char const * id, goal const & g) {
+tactic_report::tactic_report(char const * id, goal const & g):
+    m_profile(id, g) {
     if (get_verbosity_level() >= TACTIC_VERBOSITY_LVL)
         m_imp = alloc(imp, id, g);
     else
@@ -68,6 +70,136 @@ tactic_report::~tactic_report() {
         dealloc(m_imp);
 }
 
+struct tactic_profiler::node {
+    char const *       m_id;
+    unsigned           m_calls;
+    double             m_time;
+    double             m_memory_delta;
+    double             m_peak_memory;
+    unsigned           m_exprs_before;
+    unsigned           m_exprs_after;
+    unsigned           m_goal_exprs_after;
+    unsigned           m_result_calls;
+    node *             m_parent;
+    ptr_vector<node>   m_children;
+
+    node(char const * id, node * parent):
+        m_id(id), m_calls(0), m_time(0), m_memory_delta(0), m_peak_memory(0),
+        m_exprs_before(0), m_exprs_after(0), m_goal_exprs_after(0), m_result_calls(0), m_parent(parent) {}
+
+    ~node() {
+        for (node * n : m_children)
+            dealloc(n);
+    }
+
+    node * get_child(char const * id) {
+        for (node * n : m_children)
+            if (strcmp(n->m_id, id) == 0)
+                return n;
+        node * n = alloc(node, id, this);
+        m_children.push_back(n);
+        return n;
+    }
+
+    void display_json(std::ostream & out, unsigned indent) const {
+        out << std::string(indent, ' ') << "{\"tactic\": \"" << m_id << "\""
+            << ", \"calls\": " << m_calls
+            << ", \"time\": " << std::fixed << std::setprecision(3) << m_time
+            << ", \"memory-delta\": " << std::setprecision(2) << m_memory_delta
+            << ", \"peak-memory\": " << m_peak_memory
+            << ", \"exprs-before\": " << m_exprs_before;
+        if (m_result_calls > 0)
+            out << ", \"exprs-after\": " << m_exprs_after;
+        if (m_result_calls < m_calls)
+            out << ", \"goal-exprs-after\": " << m_goal_exprs_after;
+        if (!m_children.empty()) {
+            out << ",\n" << std::string(indent + 1, ' ') << "\"steps\": [\n";
+            for (unsigned i = 0; i < m_children.size(); ++i) {
+                if (i > 0)
+                    out << ",\n";
+                m_children[i]->display_json(out, indent + 2);
+            }
+            out << "]";
+        }
+        out << "}";
+    }
+};
+
+// profile node of the innermost step executed by this thread, nullptr if profiling is disabled.
+static thread_local tactic_profiler::node * g_profile_node = nullptr;
+
+static double memory_in_mb(unsigned long long sz) {
+    return static_cast<double>(sz)/static_cast<double>(1024*1024);
+}
+
+tactic_profiler::tactic_profiler():
+    m_root(alloc(node, "profile", nullptr)),
+    m_prev(g_profile_node) {
+    g_profile_node = m_root;
+}
+
+tactic_profiler::~tactic_profiler() {
+    g_profile_node = m_prev;
+    dealloc(m_root);
+}
+
+bool tactic_profiler::is_active() {
+    return g_profile_node != nullptr;
+}
+
+void tactic_profiler::display_json(std::ostream & out) const {
+    out << "[";
+    for (unsigned i = 0; i < m_root->m_children.size(); ++i) {
+        out << (i > 0 ? ",\n" : "\n");
+        m_root->m_children[i]->display_json(out, 1);
+    }
+    out << "]\n";
+}
+
+struct tactic_profile_scope::imp {
+    tactic_profiler::node * m_node;
+    goal const &            m_goal;
+    goal_ref_buffer const * m_result;
+    stopwatch               m_watch;
+    unsigned long long      m_start_memory;
+
+    imp(char const * id, goal const & g, goal_ref_buffer const * result):
+        m_node(g_profile_node->get_child(id)),
+        m_goal(g),
+        m_result(result),
+        m_start_memory(memory::get_allocation_size()) {
+        m_node->m_calls++;
+        m_node->m_exprs_before += g.num_exprs();
+        g_profile_node = m_node;
+        m_watch.start();
+    }
+
+    ~imp() {
+        m_watch.stop();
+        g_profile_node = m_node->m_parent;
+        m_node->m_time += m_watch.get_seconds();
+        m_node->m_memory_delta += memory_in_mb(memory::get_allocation_size()) - memory_in_mb(m_start_memory);
+        m_node->m_peak_memory = std::max(m_node->m_peak_memory, memory_in_mb(memory::get_max_used_memory()));
+        if (m_result) {
+            m_node->m_result_calls++;
+            for (goal * r : *m_result)
+                m_node->m_exprs_after += r->num_exprs();
+        }
+        else {
+            m_node->m_goal_exprs_after += m_goal.num_exprs();
+        }
+    }
+};
+
+tactic_profile_scope::tactic_profile_scope(char const * id, goal const & g, goal_ref_buffer const * result):
+    m_imp(g_profile_node ? alloc(imp, id, g, result) : nullptr) {
+}
+
+tactic_profile_scope::~tactic_profile_scope() {
+    if (m_imp)
+        dealloc(m_imp);
+}
+
 void report_tactic_progress(char const * id, unsigned val) {
     if (val > 0) {
         IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(" << id << " " << val << ")" << std::endl;);
@@ -144,17 +276,27 @@ tactic * mk_fail_if_undecided_tactic() {
     return alloc(fail_if_undecided_tactic);
 }
 
-void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result) {
+void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result, params_ref const & p) {
+    scoped_ptr<tactic_profiler> profiler;
+    if (!tactic_profiler::is_active() && tactic_params(p).profile())
+        profiler = alloc(tactic_profiler);
     t.reset_statistics();
     try {
-        t(in, result);
+        {
+            tactic_profile_scope _scope("tactic", *in, &result);
+            t(in, result);
+        }
         t.cleanup();
     }
     catch (tactic_exception & ex) {
         IF_VERBOSE(TACTIC_VERBOSITY_LVL, verbose_stream() << "(tactic-exception \"" << escaped(ex.msg()) << "\")" << std::endl;);
         t.cleanup();
+        if (profiler)
+            profiler->display_json(verbose_stream());
         throw ex;
     }
+    if (profiler)
+        profiler->display_json(verbose_stream());
 }
 
 
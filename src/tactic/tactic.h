@@ -90,9 +90,44 @@ typedef sref_buffer<tactic> tactic_ref_buffer;
 // minimum verbosity level for tactics
 #define TACTIC_VERBOSITY_LVL 10
 
+/**
+   \brief Hierarchical profile of tactic applications.
+
+   While a tactic_profiler is alive, every tactic_report and tactical scope
+   executed by the same thread records its time, memory and goal size 
+   before and after the step. Steps with the same name and parent are 
+   aggregated.
+
+   The size after a step is "exprs-after", the size of the resulting goals,
+   for scopes that see the result. A tactic_report only sees the input goal,
+   so it records "goal-exprs-after", the size of the input goal after the
+   step. That is the result for tactics that update the goal in place.
+*/
+class tactic_profiler {
+public:
+    struct node;
+private:
+    node *  m_root;
+    node *  m_prev;
+public:
+    tactic_profiler();
+    ~tactic_profiler();
+    void display_json(std::ostream & out) const;
+    static bool is_active();
+};
+
+class tactic_profile_scope {
+    struct imp;
+    imp *  m_imp;
+public:
+    tactic_profile_scope(char const * id, goal const & g, goal_ref_buffer const * result = nullptr);
+    ~tactic_profile_scope();
+};
+
 class tactic_report {
     struct imp;
     imp *  m_imp;
+    tactic_profile_scope m_profile;
 public:
     tactic_report(char const * id, goal const & g);
     ~tactic_report();
@@ -100,6 +135,7 @@ public:
 
 void report_tactic_progress(char const * id, unsigned val);
 
+
 class skip_tactic : public tactic {
 public:
     void operator()(goal_ref const & in, goal_ref_buffer& result) override;
@@ -120,7 +156,8 @@ tactic * mk_fail_if_undecided_tactic();
 tactic * mk_report_verbose_tactic(char const * msg, unsigned lvl);
 tactic * mk_trace_tactic(char const * tag);
 
-void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result);
+// Apply t to in. A profile is displayed on the verbose stream if tactic.profile is set in p or globally.
+void exec(tactic & t, goal_ref const & in, goal_ref_buffer & result, params_ref const & p = params_ref());
 lbool check_sat(tactic & t, goal_ref & g, model_ref & md, labels_vec & labels, proof_ref & pr, expr_dependency_ref & core, std::string & reason_unknown);
 
 // Throws an exception if goal \c in requires proof generation.
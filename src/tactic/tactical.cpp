@@ -22,6 +22,7 @@ Notes:
 #include "tactic/tactical.h"
 #ifndef SINGLE_THREAD
 #include <thread>
+#include <chrono>
 #endif
 #include <vector>
 
@@ -287,6 +288,7 @@ public:
     ~or_else_tactical() override {}
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        tactic_profile_scope _profile("or-else", *in, &result);
         goal orig(*(in.get()));
         unsigned sz = m_ts.size();
         unsigned i;
@@ -377,10 +379,108 @@ enum par_exception_kind {
     ERROR_EX
 };
 
+/**
+   \brief Worker managers of a parallel tactical and the copies of its tactics in them.
+
+   They are kept between applications of the tactical and released by cleanup, so a
+   parallel tactical that is applied repeatedly, e.g., to every subgoal of an and-then,
+   creates the managers and translates its tactics only once. Reused managers inherit
+   the definitions added to the source manager since the previous application, and the
+   source and worker managers exchange fresh ids, so fresh names created in a worker are
+   not created again in the source.
+   It also measures the time workers take to stop after they are cancelled.
+*/
+class par_workers {
+    typedef std::chrono::steady_clock clock;
+    ast_manager *                  m_src;
+    scoped_ptr_vector<ast_manager> m_managers;
+    ptr_vector<tactic>             m_src_ts;   // tactic translated into each worker manager
+    sref_vector<tactic>            m_ts;       // must be released before m_managers
+    vector<clock::time_point>      m_finish;
+    clock::time_point              m_cancel_time;
+    unsigned                       m_num_cancels;
+    double                         m_max_cancel_latency;
+public:
+    par_workers(): m_src(nullptr), m_num_cancels(0), m_max_cancel_latency(0) {}
+
+    void reset() {
+        m_ts.reset();
+        m_src_ts.reset();
+        m_managers.reset();
+        m_finish.reset();
+        m_src = nullptr;
+    }
+
+    // prepare n workers for goals in m.
+    void init(ast_manager & m, unsigned n) {
+        if (m_src != &m)
+            reset();
+        m_src = &m;
+        for (ast_manager* w : m_managers) {
+            w->copy_families_plugins(m);
+            w->update_fresh_id(m);
+        }
+        while (m_managers.size() < n) {
+            m_managers.push_back(alloc(ast_manager, m, !m.proof_mode()));
+            m_src_ts.push_back(nullptr);
+            m_ts.push_back(nullptr);
+        }
+        m_finish.resize(n);
+        for (unsigned i = 0; i < n; ++i)
+            m_managers[i]->limit().reset_cancel();
+    }
+
+    ast_manager & m(unsigned i) { return *m_managers[i]; }
+
+    // translation of t into the manager of worker i.
+    tactic & get_tactic(unsigned i, tactic * t) {
+        if (m_src_ts[i] != t) {
+            m_ts.set(i, t->translate(*m_managers[i]));
+            m_src_ts[i] = t;
+        }
+        return *m_ts.get(i);
+    }
+
+    tactic & operator[](unsigned i) { return *m_ts.get(i); }
+
+    // called by the winning worker, under the lock of the tactical, before it cancels the others.
+    void set_cancel_time() { m_cancel_time = clock::now(); }
+
+    // called by worker i to stop the other n-1 workers.
+    void cancel_others(unsigned i, unsigned n) {
+        for (unsigned j = 0; j < n; ++j)
+            if (i != j)
+                m_managers[j]->limit().cancel();
+    }
+
+    void finished(unsigned i) { m_finish[i] = clock::now(); }
+
+    // record how long the workers other than the winner took to stop, and clean up the worker tactics.
+    void done(unsigned winner, unsigned n) {
+        if (winner != UINT_MAX) {
+            double latency = 0;
+            for (unsigned j = 0; j < n; ++j)
+                if (j != winner && m_finish[j] > m_cancel_time)
+                    latency = std::max(latency, std::chrono::duration<double>(m_finish[j] - m_cancel_time).count());
+            m_max_cancel_latency = std::max(m_max_cancel_latency, latency);
+            ++m_num_cancels;
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            m_ts.get(i)->cleanup();
+            m_src->update_fresh_id(*m_managers[i]);
+        }
+    }
+
+    unsigned num_cancels() const { return m_num_cancels; }
+    double max_cancel_latency() const { return m_max_cancel_latency; }
+    void reset_statistics() { m_num_cancels = 0; m_max_cancel_latency = 0; }
+};
+
 class par_tactical : public or_else_tactical {
 
 	std::string        ex_msg;
 	unsigned           error_code;
+    par_workers        m_workers;
 
 public:
     par_tactical(unsigned num, tactic * const * ts):or_else_tactical(num, ts) {
@@ -391,6 +491,7 @@ public:
     
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        tactic_profile_scope _profile("par-or", *in, &result);
         bool use_seq;
         use_seq = false;
         if (use_seq) {
@@ -404,18 +505,16 @@ public:
         if (m.has_trace_stream())
             throw default_exception("threads and trace are incompatible");
 
-        scoped_ptr_vector<ast_manager> managers;
         scoped_limits scl(m.limit());
         goal_ref_vector                in_copies;
-        tactic_ref_vector              ts;
         unsigned sz = m_ts.size();
+        m_workers.init(m, sz);
         for (unsigned i = 0; i < sz; i++) {
-            ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
-            managers.push_back(new_m);
-            ast_translation translator(m, *new_m);
+            ast_manager & new_m = m_workers.m(i);
+            ast_translation translator(m, new_m);
             in_copies.push_back(in->translate(translator));
-            ts.push_back(m_ts.get(i)->translate(*new_m));
-            scl.push_child(&new_m->limit());
+            m_workers.get_tactic(i, m_ts.get(i));
+            scl.push_child(&new_m.limit());
         }
 
         unsigned finished_id       = UINT_MAX;
@@ -426,7 +525,7 @@ public:
         auto worker_thread = [&](unsigned i) {
             goal_ref_buffer     _result;                        
             goal_ref in_copy = in_copies[i];
-            tactic & t = *(ts.get(i));
+            tactic & t = m_workers[i];
             
             try {
                 t(in_copy, _result);
@@ -436,16 +535,13 @@ public:
                     if (finished_id == UINT_MAX) {
                         finished_id = i;
                         first = true;
+                        m_workers.set_cancel_time();
                     }
                 }                
                 if (first) {
-                    for (unsigned j = 0; j < sz; j++) {
-                        if (i != j) {
-                            managers[j]->limit().cancel();
-                        }
-                    }
+                    m_workers.cancel_others(i, sz);
                     
-                    ast_translation translator(*(managers[i]), m, false);
+                    ast_translation translator(m_workers.m(i), m, false);
                     for (goal* g : _result) {
                         result.push_back(g->translate(translator));
                     }
@@ -471,6 +567,7 @@ public:
                     ex_msg = z3_ex.msg();
                 }
             }
+            m_workers.finished(i);
         };
 
         vector<std::thread> threads(sz);
@@ -481,6 +578,8 @@ public:
         for (unsigned i = 0; i < sz; ++i) {
             threads[i].join();
         }
+        in_copies.reset();
+        m_workers.done(finished_id, sz);
         
         if (finished_id == UINT_MAX) {
             switch (ex_kind) {
@@ -492,6 +591,27 @@ public:
         }
     }    
 
+    void updt_params(params_ref const & p) override {
+        or_else_tactical::updt_params(p);
+        m_workers.reset();
+    }
+
+    void collect_statistics(statistics & st) const override {
+        or_else_tactical::collect_statistics(st);
+        st.update("par-or cancellations", m_workers.num_cancels());
+        st.update("par-or max cancel latency", m_workers.max_cancel_latency());
+    }
+
+    void reset_statistics() override {
+        or_else_tactical::reset_statistics();
+        m_workers.reset_statistics();
+    }
+
+    void cleanup() override {
+        or_else_tactical::cleanup();
+        m_workers.reset();
+    }
+
     tactic * translate(ast_manager & m) override { return translate_core<par_tactical>(m); }
 };
 
@@ -523,11 +643,13 @@ tactic * par_and_then(tactic * t1, tactic * t2) {
 }
 #else
 class par_and_then_tactical : public and_then_tactical {
+    par_workers m_workers;
 public:
     par_and_then_tactical(tactic * t1, tactic * t2):and_then_tactical(t1, t2) {}
     ~par_and_then_tactical() override {}
 
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        tactic_profile_scope _profile("par-and-then", *in, &result);
         bool use_seq;
         use_seq = false;
         if (use_seq) {
@@ -557,16 +679,16 @@ public:
         }                                                                                     
         else {                                                                                              
 
-            scoped_ptr_vector<ast_manager> managers;
-            tactic_ref_vector              ts2;
+            scoped_limits                  scl(m.limit());
             goal_ref_vector                g_copies;
 
+            m_workers.init(m, r1_size);
             for (unsigned i = 0; i < r1_size; i++) {
-                ast_manager * new_m = alloc(ast_manager, m, !m.proof_mode());
-                managers.push_back(new_m);
-                ast_translation translator(m, *new_m);
+                ast_manager & new_m = m_workers.m(i);
+                ast_translation translator(m, new_m);
                 g_copies.push_back(r1[i]->translate(translator));
-                ts2.push_back(m_t2->translate(*new_m));
+                m_workers.get_tactic(i, m_t2.get());
+                scl.push_child(&new_m.limit());
             }
 
             scoped_ptr_vector<expr_dependency_ref> core_buffer;
@@ -579,11 +701,12 @@ public:
             bool failed         = false;
             par_exception_kind ex_kind = DEFAULT_EX;
             unsigned error_code = 0;
+            unsigned winner     = UINT_MAX; // worker that cancelled the others
             std::string  ex_msg;
             std::mutex mux;
 
             auto worker_thread = [&](unsigned i) {
-                ast_manager & new_m = *(managers[i]);
+                ast_manager & new_m = m_workers.m(i);
                 goal_ref new_g = g_copies[i];
 
                 goal_ref_buffer r2;
@@ -591,7 +714,7 @@ public:
                 bool curr_failed = false;
 
                 try {
-                    ts2[i]->operator()(new_g, r2);                  
+                    m_workers[i](new_g, r2);
                 }
                 catch (tactic_exception & ex) {
                     {
@@ -601,6 +724,8 @@ public:
                             failed      = true;
                             ex_kind     = TACTIC_EX;
                             ex_msg      = ex.msg();
+                            winner      = i;
+                            m_workers.set_cancel_time();
                         }
                     }
                 }
@@ -612,6 +737,8 @@ public:
                             failed      = true;
                             ex_kind     = ERROR_EX;
                             error_code  = err.error_code();
+                            winner      = i;
+                            m_workers.set_cancel_time();
                         }
                     }                    
                 }
@@ -623,16 +750,14 @@ public:
                             failed      = true;
                             ex_kind     = DEFAULT_EX;
                             ex_msg      = z3_ex.msg();
+                            winner      = i;
+                            m_workers.set_cancel_time();
                         }
                     }
                 }
 
                 if (curr_failed) {
-                    for (unsigned j = 0; j < r1_size; j++) {
-                        if (static_cast<unsigned>(i) != j) {
-                            managers[j]->limit().cancel();
-                        }
-                    }
+                    m_workers.cancel_others(i, r1_size);
                 }
                 else {
                     if (is_decided(r2)) {
@@ -646,14 +771,12 @@ public:
                                     failed         = false;
                                     found_solution = true;
                                     first          = true;
+                                    winner         = i;
+                                    m_workers.set_cancel_time();
                                 }
                             }
                             if (first) {
-                                for (unsigned j = 0; j < r1_size; j++) {
-                                    if (static_cast<unsigned>(i) != j) {
-                                        managers[j]->limit().cancel();
-                                    }
-                                }
+                                m_workers.cancel_others(i, r1_size);
                                 ast_translation translator(new_m, m, false);
                                 SASSERT(r2.size() == 1);
                                 result.push_back(r2[0]->translate(translator));                                
@@ -681,6 +804,7 @@ public:
                         }
                     }                                                                                           
                 }
+                m_workers.finished(i);
             };
 
             if (m.has_trace_stream())
@@ -693,6 +817,8 @@ public:
             for (unsigned i = 0; i < r1_size; ++i) {
                 threads[i].join();
             }
+            g_copies.reset();
+            m_workers.done(winner, r1_size);
             
             if (failed) {
                 switch (ex_kind) {
@@ -708,7 +834,7 @@ public:
             
             expr_dependency_ref core(m);
             for (unsigned i = 0; i < r1_size; i++) {
-                ast_translation translator(*(managers[i]), m, false);
+                ast_translation translator(m_workers.m(i), m, false);
                 goal_ref_buffer * r = goals_vect[i];
                 unsigned j = result.size();
                 if (r != nullptr) {
@@ -749,8 +875,29 @@ public:
         }
     }
 
+    void updt_params(params_ref const & p) override {
+        and_then_tactical::updt_params(p);
+        m_workers.reset();
+    }
+
+    void collect_statistics(statistics & st) const override {
+        and_then_tactical::collect_statistics(st);
+        st.update("par-and-then cancellations", m_workers.num_cancels());
+        st.update("par-and-then max cancel latency", m_workers.max_cancel_latency());
+    }
+
+    void reset_statistics() override {
+        and_then_tactical::reset_statistics();
+        m_workers.reset_statistics();
+    }
+
+    void cleanup() override {
+        and_then_tactical::cleanup();
+        m_workers.reset();
+    }
+
     tactic * translate(ast_manager & m) override {
-        return translate_core<and_then_tactical>(m);
+        return translate_core<par_and_then_tactical>(m);
     }
 
 };
@@ -893,6 +1040,7 @@ public:
     }
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        tactic_profile_scope _profile("repeat", *in, &result);
         operator()(0, in, result);
     }
 
@@ -954,6 +1102,7 @@ public:
     try_for_tactical(tactic * t, unsigned ts):unary_tactical(t), m_timeout(ts) {}
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
+        tactic_profile_scope _profile("try-for", *in, &result);
         cancel_eh<reslimit> eh(in->m().limit());
         { 
             // Warning: scoped_timer is not thread safe in Linux.
@@ -1021,6 +1170,7 @@ public:
     
     void operator()(goal_ref const & in, goal_ref_buffer& result) override {
         scope _scope(m_name);
+        tactic_profile_scope _profile(m_name.c_str(), *in, &result);
         m_t->operator()(in, result);
     }
 
@@ -1047,6 +1197,7 @@ public:
     ~cond_tactical() override {}
     
     void operator()(goal_ref const & in, goal_ref_buffer & result) override {
+        tactic_profile_scope _profile("cond", *in, &result);
         if (m_p->operator()(*(in.get())).is_true()) 
             m_t1->operator()(in, result);
         else
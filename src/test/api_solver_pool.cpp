@@ -0,0 +1,130 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    api_solver_pool.cpp
+
+Abstract:
+
+    Test solvers handed out by Z3_mk_pooled_solver.
+
+--*/
+
+#include <cstring>
+#include "api/z3.h"
+#include "util/debug.h"
+#include "test/test_util.h"
+
+static unsigned get_pool_stat(Z3_context ctx, char const * key) {
+    Z3_stats st = Z3_get_solver_pool_statistics(ctx);
+    Z3_stats_inc_ref(ctx, st);
+    unsigned r = get_stat(ctx, st, key);
+    Z3_stats_dec_ref(ctx, st);
+    return r;
+}
+
+// only memory and resource statistics are reported for a solver that did no work.
+static bool has_solver_statistics(Z3_context ctx, Z3_solver s) {
+    Z3_stats st = Z3_solver_get_statistics(ctx, s);
+    Z3_stats_inc_ref(ctx, st);
+    bool r = false;
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i) {
+        char const * k = Z3_stats_get_key(ctx, st, i);
+        if (strcmp(k, "memory") && strcmp(k, "max memory") && strcmp(k, "num allocs") && strcmp(k, "rlimit count"))
+            r = true;
+    }
+    Z3_stats_dec_ref(ctx, st);
+    return r;
+}
+
+void tst_api_solver_pool() {
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context_rc(cfg);
+    Z3_symbol lia = Z3_mk_string_symbol(ctx, "QF_LIA");
+    Z3_sort int_sort = Z3_mk_int_sort(ctx);
+    Z3_ast x = Z3_mk_const(ctx, Z3_mk_string_symbol(ctx, "x"), int_sort);
+    Z3_inc_ref(ctx, x);
+    Z3_ast zero = Z3_mk_int(ctx, 0, int_sort);
+    Z3_inc_ref(ctx, zero);
+
+    Z3_solver s1 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s1);
+    ENSURE(Z3_solver_get_num_scopes(ctx, s1) == 0);
+    Z3_solver_assert(ctx, s1, Z3_mk_gt(ctx, x, zero));
+    ENSURE(Z3_solver_check(ctx, s1) == Z3_L_TRUE);
+    Z3_solver_assert(ctx, s1, Z3_mk_false(ctx));
+    ENSURE(Z3_solver_check(ctx, s1) == Z3_L_FALSE);
+    ENSURE(has_solver_statistics(ctx, s1));
+    Z3_solver_dec_ref(ctx, s1);
+
+    // the second solver is the first one with its assertions popped and its statistics reset.
+    // Creating it releases s1, which the context held as the last returned object.
+    Z3_solver s2 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s2);
+    ENSURE(Z3_solver_get_num_scopes(ctx, s2) == 0);
+    ENSURE(!has_solver_statistics(ctx, s2));
+    ENSURE(Z3_solver_check(ctx, s2) == Z3_L_TRUE);
+    ENSURE(get_pool_stat(ctx, "solver pool created") == 1);
+    ENSURE(get_pool_stat(ctx, "solver pool reused") == 1);
+    ENSURE(get_pool_stat(ctx, "solver pool returned") == 1);
+
+    // a solver that imported a model converter is not returned to the pool.
+    Z3_solver src = Z3_mk_simple_solver(ctx);
+    Z3_solver_inc_ref(ctx, src);
+    ENSURE(Z3_solver_check(ctx, src) == Z3_L_TRUE);
+    Z3_solver_import_model_converter(ctx, src, s2);
+    Z3_solver_dec_ref(ctx, src);
+    Z3_solver_dec_ref(ctx, s2);
+    Z3_solver s3 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s3);
+    ENSURE(get_pool_stat(ctx, "solver pool created") == 2);
+    ENSURE(get_pool_stat(ctx, "solver pool returned") == 1);
+    Z3_solver_dec_ref(ctx, s3);
+
+    // a solver handed out before the global parameters change is not returned
+    // to the pool, and idle solvers created before are not reused.
+    Z3_solver s4 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s4);
+    Z3_solver s5 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s5);
+    Z3_solver_dec_ref(ctx, s4);
+    unsigned returned = get_pool_stat(ctx, "solver pool returned");
+    ENSURE(get_pool_stat(ctx, "solver pool idle") > 0);
+    Z3_global_param_set("smt.random_seed", "3");
+    Z3_solver_dec_ref(ctx, s5);
+    unsigned created = get_pool_stat(ctx, "solver pool created");
+    ENSURE(get_pool_stat(ctx, "solver pool returned") == returned);
+    Z3_solver s6 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s6);
+    ENSURE(get_pool_stat(ctx, "solver pool created") == created + 1);
+    Z3_solver_dec_ref(ctx, s6);
+    Z3_global_param_reset_all();
+
+    // the solvers that were pooled before the change are reused again.
+    unsigned reused = get_pool_stat(ctx, "solver pool reused");
+    Z3_solver s7 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s7);
+    ENSURE(get_pool_stat(ctx, "solver pool reused") == reused + 1);
+    Z3_solver_dec_ref(ctx, s7);
+
+    // updating the context parameters empties the pool, and a pool size of 0 disables reuse.
+    ENSURE(get_pool_stat(ctx, "solver pool idle") > 0);
+    Z3_update_param_value(ctx, "solver_pool_size", "0");
+    ENSURE(get_pool_stat(ctx, "solver pool idle") == 0);
+    reused = get_pool_stat(ctx, "solver pool reused");
+    Z3_solver s8 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s8);
+    Z3_solver_dec_ref(ctx, s8);
+    Z3_solver s9 = Z3_mk_pooled_solver(ctx, lia, nullptr);
+    Z3_solver_inc_ref(ctx, s9);
+    Z3_solver_dec_ref(ctx, s9);
+    ENSURE(get_pool_stat(ctx, "solver pool idle") == 0);
+    ENSURE(get_pool_stat(ctx, "solver pool reused") == reused);
+    ENSURE(get_pool_stat(ctx, "solver pool discarded") > 0);
+
+    Z3_dec_ref(ctx, x);
+    Z3_dec_ref(ctx, zero);
+    Z3_del_config(cfg);
+    Z3_del_context(ctx);
+}
@@ -1,4 +1,5 @@
 #include "math/dd/dd_bdd.h"
+#include "test/test_util.h"
 
 namespace dd {
     static void test1() {
@@ -73,6 +74,40 @@ namespace dd {
         std::cout << c1 << "\n";
         std::cout << c1.bdd_size() << "\n";
     }
+
+    // build BDDs with a bad variable order, so that the operation cache
+    // fills up, and return their sizes.
+    static vector<double> cache_workload(bdd_manager& m) {
+        unsigned n = 12;
+        bdd f = m.mk_false(), g = m.mk_false();
+        for (unsigned i = 0; i < n / 2; ++i) {
+            f |= m.mk_var(i) && m.mk_var(i + n / 2);
+            bdd v = m.mk_var((3 * i) % n);
+            g = (g && !v) || (!g && v);
+        }
+        bdd h = m.mk_exists(0, f && g);
+        h = m.mk_exists(n / 2, h);
+        // canonicity is kept when entries are evicted.
+        VERIFY((f || g) == !(!f && !g));
+        VERIFY(h == m.mk_exists(n / 2, m.mk_exists(0, g && f)));
+        vector<double> sizes;
+        sizes.push_back(f.bdd_size());
+        sizes.push_back(g.bdd_size());
+        sizes.push_back(h.bdd_size());
+        sizes.push_back(h.cnf_size());
+        sizes.push_back(h.dnf_size());
+        return sizes;
+    }
+
+    static void cache_budget() {
+        bdd_manager m1(20), m2(20);
+        m2.set_max_cache_size(16);
+        vector<double> s1 = cache_workload(m1);
+        vector<double> s2 = cache_workload(m2);
+        VERIFY(s1 == s2);
+        VERIFY(get_stat(m1, "dd.bdd.cache-evictions") == 0);
+        VERIFY(get_stat(m2, "dd.bdd.cache-evictions") > 0);
+    }
 }
 
 void tst_bdd() {
@@ -80,4 +115,5 @@ void tst_bdd() {
     dd::test2();
     dd::test3();
     dd::test4();
+    dd::cache_budget();
 }
@@ -0,0 +1,107 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    bv_delay.cpp
+
+Abstract:
+
+    Check that the bit-vector solver of the SAT core (sat.euf) delays
+    bit-blasting of shifts and multiplications of variables when
+    smt.bv.delay is set, and that the refinements do not change results.
+
+--*/
+
+#include <cstring>
+#include "api/z3.h"
+#include "util/debug.h"
+#include "test/test_util.h"
+
+struct bv_delay_result {
+    Z3_lbool r;
+    unsigned axioms;
+    unsigned bit_blasts;
+    unsigned low_bits_lemmas;
+    unsigned repairs;
+};
+
+static bv_delay_result check_bv_delay(char const * benchmark, bool delay) {
+    Z3_global_param_set("sat.euf", "true");
+    Z3_global_param_set("tactic.default_tactic", "sat");
+    Z3_global_param_set("smt.bv.delay", delay ? "true" : "false");
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context_rc(cfg);
+    Z3_del_config(cfg);
+    Z3_solver s = Z3_mk_solver(ctx);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_from_string(ctx, s, benchmark);
+    bv_delay_result result;
+    result.r = Z3_solver_check(ctx, s);
+    Z3_stats st = Z3_solver_get_statistics(ctx, s);
+    Z3_stats_inc_ref(ctx, st);
+    result.axioms = get_stat(ctx, st, "bv delay axioms");
+    result.bit_blasts = get_stat(ctx, st, "bv delay bit-blasts");
+    result.low_bits_lemmas = get_stat(ctx, st, "bv low bits lemmas");
+    result.repairs = get_stat(ctx, st, "bv phase repairs");
+    Z3_stats_dec_ref(ctx, st);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_del_context(ctx);
+    Z3_global_param_reset_all();
+    return result;
+}
+
+static bv_delay_result check_bv_delay(char const * benchmark, Z3_lbool expected) {
+    bv_delay_result eager = check_bv_delay(benchmark, false);
+    ENSURE(eager.r == expected);
+    ENSURE(eager.axioms == 0 && eager.bit_blasts == 0 && eager.low_bits_lemmas == 0 && eager.repairs == 0);
+    bv_delay_result lazy = check_bv_delay(benchmark, true);
+    ENSURE(lazy.r == expected);
+    return lazy;
+}
+
+static char const * shift_zero =
+    "(declare-const x (_ BitVec 32))\n"
+    "(declare-const y (_ BitVec 32))\n"
+    "(declare-const z (_ BitVec 32))\n"
+    "(assert (= (bvshl x y) z))\n"
+    "(assert (bvult y #x00000008))\n"
+    "(assert (= z #x00000100))\n"
+    "(assert (not (= x #x00000001)))\n";
+
+static char const * lshr_large =
+    "(declare-const x (_ BitVec 32))\n"
+    "(declare-const y (_ BitVec 32))\n"
+    "(assert (= (bvlshr x y) #x00000001))\n"
+    "(assert (bvugt y #x00000010))\n";
+
+static char const * mul_odd =
+    "(declare-const x (_ BitVec 32))\n"
+    "(declare-const z (_ BitVec 32))\n"
+    "(assert (= (bvmul x z) #x12345678))\n";
+
+static char const * shift_mul =
+    "(declare-const x (_ BitVec 32))\n"
+    "(declare-const y (_ BitVec 32))\n"
+    "(declare-const z (_ BitVec 32))\n"
+    "(assert (= (bvshl x y) (bvmul z #x00000010)))\n"
+    "(assert (= (bvmul x z) #x12345678))\n"
+    "(assert (bvult y #x00000008))\n";
+
+void tst_bv_delay() {
+    // the candidate model shifts by 0, which is repaired by an axiom.
+    bv_delay_result r = check_bv_delay(shift_zero, Z3_L_TRUE);
+    ENSURE(r.axioms > 0);
+    // a shift by a non-zero amount below the bit-width is bit-blasted.
+    r = check_bv_delay(lshr_large, Z3_L_TRUE);
+    ENSURE(r.bit_blasts > 0);
+    // candidate products that disagree on the low bits are refined
+    // by lemmas on the low bits of the arguments.
+    r = check_bv_delay(mul_odd, Z3_L_TRUE);
+    ENSURE(r.low_bits_lemmas > 0);
+    // the phases of the arguments are repaired towards the product.
+    ENSURE(r.repairs > 0);
+    r = check_bv_delay(shift_mul, Z3_L_FALSE);
+    ENSURE(r.axioms + r.bit_blasts > 0);
+    ENSURE(r.low_bits_lemmas > 0);
+}
@@ -0,0 +1,73 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    horner_cache.cpp
+
+Abstract:
+
+    Check that rows for which horner's heuristic found no conflict are
+    skipped for at most smt.arith.nl.horner_row_cache_skips rounds, and
+    that skipping rows does not change results.
+
+--*/
+
+#include "api/z3.h"
+#include "util/debug.h"
+#include "test/test_util.h"
+
+static char const * nl_benchmark =
+    "(declare-const a Int)\n"
+    "(declare-const b Int)\n"
+    "(declare-const c Int)\n"
+    "(declare-const d Int)\n"
+    "(assert (< 0 a 23))\n"
+    "(assert (< 0 b 23))\n"
+    "(assert (< 0 c 23))\n"
+    "(assert (< 0 d 23))\n"
+    "(assert (= (+ (* a b) (* a c) (* b d)) (+ (* c d) 997)))\n"
+    "(assert (= (+ (* a d) (* b c)) (+ (* a a) 13)))\n";
+
+struct horner_cache_result {
+    Z3_lbool r;
+    unsigned hits;
+    unsigned expired;
+};
+
+static horner_cache_result check_horner_cache(char const * skips) {
+    Z3_global_param_set("smt.arith.nl.horner_row_cache_skips", skips);
+    Z3_config cfg = Z3_mk_config();
+    Z3_context ctx = Z3_mk_context_rc(cfg);
+    Z3_del_config(cfg);
+    Z3_tactic t = Z3_mk_tactic(ctx, "smt");
+    Z3_tactic_inc_ref(ctx, t);
+    Z3_solver s = Z3_mk_solver_from_tactic(ctx, t);
+    Z3_solver_inc_ref(ctx, s);
+    Z3_solver_from_string(ctx, s, nl_benchmark);
+    horner_cache_result result;
+    result.r = Z3_solver_check(ctx, s);
+    Z3_stats st = Z3_solver_get_statistics(ctx, s);
+    Z3_stats_inc_ref(ctx, st);
+    result.hits = get_stat(ctx, st, "arith-horner-cache-hits");
+    result.expired = get_stat(ctx, st, "arith-horner-cache-expired");
+    Z3_stats_dec_ref(ctx, st);
+    Z3_solver_dec_ref(ctx, s);
+    Z3_tactic_dec_ref(ctx, t);
+    Z3_del_context(ctx);
+    Z3_global_param_reset_all();
+    return result;
+}
+
+void tst_horner_cache() {
+    horner_cache_result r = check_horner_cache("0");
+    ENSURE(r.r == Z3_L_FALSE);
+    ENSURE(r.hits == 0 && r.expired == 0);
+    // a row is checked again after it was skipped once.
+    r = check_horner_cache("1");
+    ENSURE(r.r == Z3_L_FALSE);
+    ENSURE(r.hits > 0 && r.expired > 0);
+    r = check_horner_cache("8");
+    ENSURE(r.r == Z3_L_FALSE);
+    ENSURE(r.hits > 0);
+}
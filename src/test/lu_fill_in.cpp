@@ -0,0 +1,64 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    lu_fill_in.cpp
+
+Abstract:
+
+    Check that the LU factorization counts the non-zeroes that column
+    replacements add to U, and refactors once U has more than doubled.
+
+--*/
+
+#include "math/lp/static_matrix.h"
+#include "math/lp/lu_def.h"
+
+using namespace lp;
+
+typedef lu<static_matrix<double, double>> lu_t;
+
+static void replace(lu_t & l, vector<unsigned> & basis, unsigned entering, unsigned position) {
+    indexed_vector<double> w(basis.size());
+    l.prepare_entering(entering, w);
+    l.replace_column(0, w, position);
+    basis[position] = entering;
+    ENSURE(l.get_status() == LU_status::OK);
+}
+
+void tst_lu_fill_in() {
+    unsigned n = 8;
+    // columns 0..n-1 are the identity, column n is 2 * e_0 and the
+    // remaining columns are dense.
+    static_matrix<double, double> A(n, 2 * n + 1);
+    for (unsigned i = 0; i < n; ++i)
+        A(i, i) = 1;
+    A(0, n) = 2;
+    for (unsigned j = n + 1; j < 2 * n + 1; ++j)
+        for (unsigned i = 0; i < n; ++i)
+            A(i, j) = (i == j - n - 1) ? n + 1 : 1;
+    vector<unsigned> basis;
+    for (unsigned i = 0; i < n; ++i)
+        basis.push_back(i);
+    lp_settings settings;
+    lu_t l(A, basis, settings);
+    ENSURE(l.m_factorization_size == n);
+    ENSURE(l.m_fill_in == 0);
+
+    // the entering column has the sparsity of the leaving one, U keeps its size.
+    replace(l, basis, n, 0);
+    ENSURE(l.m_fill_in == 0);
+    ENSURE(!l.need_to_refactor());
+    ENSURE(l.is_correct(basis));
+
+    // dense entering columns add non-zeroes to U until it has doubled.
+    unsigned i = 1;
+    for (; i < n && !l.need_to_refactor(); ++i) {
+        replace(l, basis, n + i, i);
+        ENSURE(l.m_fill_in > 0);
+        ENSURE(l.is_correct(basis));
+    }
+    ENSURE(l.need_to_refactor());
+    ENSURE(i < n);
+}
@@ -168,11 +168,16 @@ int main(int argc, char ** argv) {
     TST(uint_set);
     TST_ARGV(expr_rand);
     TST(list);
+    TST(lu_fill_in);
     TST(small_object_allocator);
     TST(timeout);
     TST(proof_checker);
     TST(simplifier);
+    TST(simplify_tactic);
+    TST(tactic_profile);
+    TST(th_rewriter);
     TST(bit_blaster);
+    TST(bv_delay);
     TST(var_subst);
     TST(simple_parser);
     TST(api);
@@ -200,10 +205,16 @@ int main(int argc, char ** argv) {
     TST(ex);
     TST(nlarith_util);
     TST(api_bug);
+    TST(api_solver_pool);
     TST(arith_rewriter);
     TST(check_assumptions);
     TST(smt_context);
+    TST(smt_kernel);
+    TST_ARGV(smt_kernel_reset_latency);
+    TST(solve_eqs);
+    TST_ARGV(solve_eqs_chain);
     TST(theory_dl);
+    TST(theory_diff_logic);
     TST(model_retrieval);
     TST(model_based_opt);
     TST(factor_rewriter);
@@ -231,6 +242,7 @@ int main(int argc, char ** argv) {
     TST(horn_subsume_model_converter);
     TST(model2expr);
     TST(hilbert_basis);
+    TST(horner_cache);
     TST(heap_trie);
     TST(karr);
     TST(no_overflow);
@@ -247,6 +259,8 @@ int main(int argc, char ** argv) {
     TST(theory_pb);
     TST(simplex);
     TST(sat_user_scope);
+    TST(sat_inprocess);
+    TST(sat_reuse_trail);
     TST_ARGV(ddnf);
     TST(ddnf1);
     TST(model_evaluator);
@@ -254,11 +268,13 @@ int main(int argc, char ** argv) {
     TST(pb2bv);
     TST_ARGV(sat_lookahead);
     TST_ARGV(sat_local_search);
+    TST_ARGV(sat_local_search_flips);
     TST_ARGV(cnf_backbones);
     TST(bdd);
     TST(pdd);
     TST(pdd_solver);
     TST(solver_pool);
+    TST(parallel_tactic);
     //TST_ARGV(hs);
     TST(finder);
 }
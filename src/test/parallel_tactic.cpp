@@ -0,0 +1,102 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    parallel_tactic.cpp
+
+Abstract:
+
+    Check that the units shared by parallel_tactic after a check that
+    stopped on a conflict limit are implied by the assertions, and that
+    tasks share and import lemmas.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/ast_pp.h"
+#include "model/model.h"
+#include "tactic/tactic.h"
+#include "solver/parallel_tactic.h"
+#include "sat/sat_solver/inc_sat_solver.h"
+#include "util/util.h"
+#include "util/statistics.h"
+#include <thread>
+#include "test/test_util.h"
+
+template<typename T>
+static void add_random_3sat(ast_manager& m, T& s, expr_ref_vector const& vars, unsigned num_clauses, random_gen& r) {
+    expr_ref_vector clause(m);
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        clause.reset();
+        for (unsigned j = 0; j < 3; ++j) {
+            expr* v = vars[r(vars.size())];
+            clause.push_back(r(2) ? v : m.mk_not(v));
+        }
+        s.assert_expr(m.mk_or(clause));
+    }
+}
+
+// the tasks created by splitting a random 3-SAT instance into cubes share 
+// units and refuted cubes, and import the lemmas shared by other tasks.
+static void check_sharing(ast_manager& m, expr_ref_vector const& vars) {
+    random_gen r(0);
+    goal_ref g = alloc(goal, m);
+    add_random_3sat(m, *g, vars, 5 * vars.size(), r);
+    params_ref p;
+    p.set_uint("threads.max", 2);
+    // stop simplification early, so the instance is split into cubes.
+    p.set_uint("simplify.max_conflicts", 100);
+    tactic_ref t = mk_parallel_tactic(mk_inc_sat_solver(m, p), p);
+    goal_ref_buffer result;
+    (*t)(g, result);
+    statistics st;
+    t->collect_statistics(st);
+    ENSURE(get_stat(st, "par shared units") + get_stat(st, "par shared conflicts") > 0);
+    ENSURE(get_stat(st, "par imported lemmas") > 0);
+    // the second thread only gets tasks by stealing them.
+    if (std::thread::hardware_concurrency() > 1)
+        ENSURE(get_stat(st, "par steals") > 0);
+}
+
+void tst_parallel_tactic() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned num_vars = 200;
+    expr_ref_vector vars(m);
+    for (unsigned i = 0; i < num_vars; ++i)
+        vars.push_back(m.mk_const(symbol(i), m.mk_bool_sort()));
+
+    for (unsigned seed = 0; seed < 5; ++seed) {
+        random_gen r(seed);
+        params_ref p;
+        p.set_uint("max_conflicts", 20);
+        solver_ref bounded = mk_inc_sat_solver(m, p);
+        solver_ref full = mk_inc_sat_solver(m, params_ref());
+        // unit x0 and x0 => x1 are implied at the base level.
+        bounded->assert_expr(vars.get(0));
+        bounded->assert_expr(m.mk_implies(vars.get(0), vars.get(1)));
+        full->assert_expr(vars.get(0));
+        full->assert_expr(m.mk_implies(vars.get(0), vars.get(1)));
+        random_gen r2(seed);
+        add_random_3sat(m, *bounded, vars, 4 * num_vars, r);
+        add_random_3sat(m, *full, vars, 4 * num_vars, r2);
+
+        if (full->check_sat() != l_true)
+            continue;
+        model_ref mdl;
+        full->get_model(mdl);
+
+        bounded->check_sat();
+        expr_ref_vector units = get_base_level_units(*bounded);
+        ENSURE(units.contains(vars.get(0)));
+        ENSURE(units.contains(vars.get(1)));
+        for (expr* u : units) {
+            if (!mdl->is_true(u)) {
+                std::cout << "unit " << mk_pp(u, m) << " is not implied\n";
+                ENSURE(false);
+            }
+        }
+    }
+    check_sharing(m, vars);
+}
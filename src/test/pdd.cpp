@@ -1,4 +1,5 @@
 #include "math/dd/dd_pdd.h"
+#include "test/test_util.h"
 
 namespace dd {
 
@@ -284,6 +285,45 @@ public :
         
     }
 
+    /**
+     * run mul, reduce and spoly on a manager with a tiny operation cache
+     * and compare results with an unbounded manager.
+     */
+    static pdd_manager::monomials_t cache_workload(pdd_manager& m) {
+        unsigned n = 6;
+        vector<pdd> vs;
+        for (unsigned i = 0; i < n; ++i)
+            vs.push_back(m.mk_var(i));
+        pdd p = m.zero(), q = m.zero();
+        for (unsigned i = 0; i < n; ++i) {
+            p += vs[i] * vs[(i + 1) % n] + rational(i + 1);
+            q += vs[i] * vs[i] - vs[(i + 2) % n];
+        }
+        pdd r = p * q;
+        r = r * (p + q);
+        for (unsigned i = 0; i < n; ++i)
+            r = r.reduce(vs[i] * vs[(i + 3) % n] - vs[i]);
+        pdd s = m.zero();
+        if (m.try_spoly(p * vs[0], q * vs[0], s))
+            r += s;
+        return m.to_monomials(r);
+    }
+
+    static void cache_budget() {
+        std::cout << "\ncache budget\n";
+        pdd_manager m1(6), m2(6);
+        m2.set_max_cache_size(64);
+        auto r1 = cache_workload(m1);
+        auto r2 = cache_workload(m2);
+        VERIFY(r1.size() == r2.size());
+        for (unsigned i = 0; i < r1.size(); ++i) {
+            VERIFY(r1[i].first == r2[i].first);
+            VERIFY(r1[i].second == r2[i].second);
+        }
+        VERIFY(get_stat(m1, "dd.pdd.cache-evictions") == 0);
+        VERIFY(get_stat(m2, "dd.pdd.cache-evictions") > 0);
+    }
+
 };
 
 }
@@ -297,4 +337,5 @@ void tst_pdd() {
     dd::test::iterator();
     dd::test::order();
     dd::test::order_lm();
+    dd::test::cache_budget();
 }
@@ -0,0 +1,190 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    sat_inprocess.cpp
+
+Abstract:
+
+    Check inprocessing of the SAT solver: the scheduling of passes
+    (sat.inprocess.backoff), vivification of learned clauses, gate-aware
+    variable elimination and bounded variable addition.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "sat/sat_asymm_branch.h"
+#include "util/statistics.h"
+#include "test/test_util.h"
+
+// n pigeons in n - 1 holes.
+static void add_pigeon_hole(sat::solver & s, unsigned n) {
+    unsigned h = n - 1;
+    for (unsigned i = 0; i < n * h; ++i)
+        s.mk_var();
+    sat::literal_vector lits;
+    for (unsigned p = 0; p < n; ++p) {
+        lits.reset();
+        for (unsigned q = 0; q < h; ++q)
+            lits.push_back(sat::literal(p * h + q, false));
+        s.mk_clause(lits.size(), lits.c_ptr());
+    }
+    for (unsigned q = 0; q < h; ++q)
+        for (unsigned a = 0; a < n; ++a)
+            for (unsigned b = a + 1; b < n; ++b)
+                s.mk_clause(sat::literal(a * h + q, true), sat::literal(b * h + q, true));
+}
+
+static void check_backoff(bool backoff, unsigned & runs, unsigned & skips) {
+    params_ref p;
+    p.set_bool("inprocess.backoff", backoff);
+    // simplify often so that the passes are scheduled many times.
+    p.set_uint("next_simplify", 100);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    add_pigeon_hole(s, 8);
+    ENSURE(s.check() == l_false);
+    runs = get_stat(s, "sat inprocess probing runs") + get_stat(s, "sat inprocess asymm branch runs");
+    skips = get_stat(s, "sat inprocess probing skips") + get_stat(s, "sat inprocess asymm branch skips");
+}
+
+// the learned clauses a or b or c or d and a or b or c or e are shortened
+// to a or b or c, which is an input clause.
+static void check_vivify() {
+    params_ref p;
+    p.set_bool("asymm_branch.vivify", true);
+    p.set_uint("asymm_branch.delay", 0);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    sat::literal a(s.mk_var(), false), b(s.mk_var(), false), c(s.mk_var(), false);
+    sat::literal d(s.mk_var(), false), e(s.mk_var(), false);
+    s.mk_clause(a, b, c);
+    sat::literal lits1[4] = { d, a, b, c };
+    sat::literal lits2[4] = { e, c, b, a };
+    sat::clause * c1 = s.mk_clause(4, lits1, sat::status::redundant());
+    sat::clause * c2 = s.mk_clause(4, lits2, sat::status::redundant());
+    c1->set_glue(2);
+    c2->set_glue(2);
+    sat::asymm_branch ab(s, p);
+    ab(true);
+    ENSURE(c1->size() == 3 && !c1->contains(d));
+    ENSURE(c2->size() == 3 && !c2->contains(e));
+    statistics st;
+    ab.collect_statistics(st);
+    ENSURE(get_stat(st, "sat vivified clauses") == 2);
+    ENSURE(get_stat(st, "sat vivify literals") == 2);
+}
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void add_clause(sat::solver & s, clauses_t & clauses, sat::literal_vector const & lits) {
+    clauses.push_back(lits);
+    s.mk_clause(lits);
+}
+
+static void add_clause(sat::solver & s, clauses_t & clauses, sat::literal l1, sat::literal l2) {
+    sat::literal_vector lits;
+    lits.push_back(l1);
+    lits.push_back(l2);
+    add_clause(s, clauses, lits);
+}
+
+static void check_model(sat::solver & s, clauses_t const & clauses) {
+    for (sat::literal_vector const & lits : clauses) {
+        bool sat = false;
+        for (sat::literal l : lits)
+            sat |= sat::value_at(l, s.get_model()) == l_true;
+        ENSURE(sat);
+    }
+}
+
+// g = a & b, g is used in two positive and two negative clauses.
+// Resolving only gate clauses against non-gate clauses produces 6 clauses
+// instead of the 7 clauses of g, so g is only eliminated when gates are used.
+static void check_elim_gates(bool gates) {
+    params_ref p;
+    p.set_bool("elim_vars_gates", gates);
+    p.set_bool("override_incremental", true);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    // keep the external variables from being eliminated.
+    s.set_incremental(true);
+    clauses_t clauses;
+    sat::literal g(s.mk_var(), false);
+    sat::literal_vector ls;
+    for (unsigned i = 0; i < 6; ++i)
+        ls.push_back(sat::literal(s.mk_var(true), false));
+    sat::literal a = ls[0], b = ls[1];
+    add_clause(s, clauses, ~g, a);
+    add_clause(s, clauses, ~g, b);
+    sat::literal_vector lits;
+    lits.push_back(g);
+    lits.push_back(~a);
+    lits.push_back(~b);
+    add_clause(s, clauses, lits);
+    add_clause(s, clauses, g, ls[2]);
+    add_clause(s, clauses, g, ls[3]);
+    add_clause(s, clauses, ~g, ls[4]);
+    add_clause(s, clauses, ~g, ls[5]);
+    s.simplify(false);
+    ENSURE(s.was_eliminated(g.var()) == gates);
+    ENSURE((get_stat(s, "sat elim gates") > 0) == gates);
+    ENSURE(s.check() == l_true);
+    check_model(s, clauses);
+}
+
+// pairwise at-most-one constraints over n literals.
+static void add_at_most_one(sat::solver & s, clauses_t & clauses, sat::literal_vector const & lits) {
+    for (unsigned i = 0; i < lits.size(); ++i)
+        for (unsigned j = i + 1; j < lits.size(); ++j)
+            add_clause(s, clauses, ~lits[i], ~lits[j]);
+}
+
+// n pigeons in h holes with pairwise at-most-one constraints on the holes.
+static void check_bva(unsigned n, unsigned h, lbool expected) {
+    params_ref p;
+    p.set_bool("bva", true);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    clauses_t clauses;
+    for (unsigned i = 0; i < n * h; ++i)
+        s.mk_var();
+    sat::literal_vector lits;
+    for (unsigned i = 0; i < n; ++i) {
+        lits.reset();
+        for (unsigned j = 0; j < h; ++j)
+            lits.push_back(sat::literal(i * h + j, false));
+        add_clause(s, clauses, lits);
+    }
+    for (unsigned j = 0; j < h; ++j) {
+        lits.reset();
+        for (unsigned i = 0; i < n; ++i)
+            lits.push_back(sat::literal(i * h + j, false));
+        add_at_most_one(s, clauses, lits);
+    }
+    s.simplify(false);
+    ENSURE(get_stat(s, "sat bva vars") > 0);
+    ENSURE(get_stat(s, "sat bva removed binaries") > 0);
+    ENSURE(s.check() == expected);
+    if (expected == l_true)
+        check_model(s, clauses);
+}
+
+void tst_sat_inprocess() {
+    check_vivify();
+    check_elim_gates(false);
+    check_elim_gates(true);
+    check_bva(8, 8, l_true);
+    check_bva(7, 6, l_false);
+    unsigned runs = 0, skips = 0;
+    // by default every pass runs in every simplification round.
+    check_backoff(false, runs, skips);
+    ENSURE(runs > 2);
+    ENSURE(skips == 0);
+    unsigned all_runs = runs;
+    // unproductive passes are postponed.
+    check_backoff(true, runs, skips);
+    ENSURE(skips > 0);
+    ENSURE(runs < all_runs);
+}
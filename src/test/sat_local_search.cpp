@@ -1,5 +1,8 @@
 #include "sat/sat_local_search.h"
+#include "sat/sat_ddfw.h"
 #include "sat/sat_solver.h"
+#include "util/statistics.h"
+#include "util/stopwatch.h"
 #include "util/cancel_eh.h"
 #include "util/scoped_ctrl_c.h"
 #include "util/scoped_timer.h"
@@ -126,3 +129,56 @@ void tst_sat_local_search(char ** argv, int argc, int& i) {
     local_search.check(0, nullptr, nullptr);    
 
 }
+
+// random 3-SAT near the phase transition, large enough that local search 
+// does not finish within the time budget.
+static void mk_random_3sat(sat::solver& s, unsigned num_vars, unsigned num_clauses, unsigned seed) {
+    random_gen r(seed);
+    for (unsigned v = 0; v < num_vars; ++v)
+        s.mk_var();
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal lits[3];
+        for (unsigned j = 0; j < 3; ++j)
+            lits[j] = sat::literal(r() % num_vars, r() % 2 == 0);
+        if (lits[0].var() == lits[1].var() || lits[0].var() == lits[2].var() || lits[1].var() == lits[2].var())
+            continue;
+        s.mk_clause(3, lits);
+    }
+}
+
+static void run_flips(char const* name, sat::i_local_search& ls, unsigned ms) {
+    statistics st;
+    stopwatch sw;
+    cancel_eh<reslimit> eh(ls.rlimit());
+    sw.start();
+    {
+        scoped_timer timer(ms, &eh);
+        ls.check(0, nullptr, nullptr);
+    }
+    sw.stop();
+    ls.collect_statistics(st);
+    std::cout << name << " seconds: " << sw.get_seconds() << "\n";
+    st.display(std::cout);
+}
+
+// benchmark of the flip rate: sat_local_search_flips [milliseconds]
+void tst_sat_local_search_flips(char ** argv, int argc, int& i) {
+    unsigned ms = 500;
+    if (i + 1 < argc) {
+        ms = atoi(argv[i + 1]);
+        ++i;
+    }
+    reslimit limit;
+    params_ref params;
+    sat::solver s(params, limit);
+    mk_random_3sat(s, 20000, 85000, 7);
+
+    sat::local_search ls;
+    ls.import(s, true);
+    run_flips("local-search", ls, ms);
+
+    sat::ddfw d;
+    d.updt_params(params);
+    d.add(s);
+    run_flips("ddfw", d, ms);
+}
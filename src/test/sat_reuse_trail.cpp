@@ -0,0 +1,70 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    sat_reuse_trail.cpp
+
+Abstract:
+
+    Check that keeping decision levels on backjumps (sat.backtrack.reuse_trail)
+    does not change results and that levels are kept on random 3-SAT.
+
+--*/
+
+#include "sat/sat_solver.h"
+#include "util/util.h"
+#include "test/test_util.h"
+
+typedef vector<sat::literal_vector> clauses_t;
+
+static void mk_random_3sat(random_gen & r, unsigned num_vars, unsigned num_clauses, clauses_t & clauses) {
+    for (unsigned i = 0; i < num_clauses; ++i) {
+        sat::literal_vector lits;
+        for (unsigned j = 0; j < 3; ++j)
+            lits.push_back(sat::literal(r(num_vars), r(2) == 0));
+        clauses.push_back(lits);
+    }
+}
+
+static lbool check_reuse_trail(unsigned num_vars, clauses_t const & clauses, bool reuse, unsigned & reused) {
+    params_ref p;
+    p.set_bool("backtrack.reuse_trail", reuse);
+    // backjump on every conflict so that levels can be kept from the start.
+    p.set_uint("backtrack.conflicts", 0);
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i < num_vars; ++i)
+        s.mk_var();
+    for (sat::literal_vector const & lits : clauses)
+        s.mk_clause(lits);
+    lbool r = s.check();
+    if (r == l_true) {
+        for (sat::literal_vector const & lits : clauses) {
+            bool sat = false;
+            for (sat::literal l : lits)
+                sat |= sat::value_at(l, s.get_model()) == l_true;
+            ENSURE(sat);
+        }
+    }
+    reused = get_stat(s, "sat reused scopes");
+    return r;
+}
+
+void tst_sat_reuse_trail() {
+    random_gen r(0);
+    unsigned total = 0;
+    for (unsigned i = 0; i < 20; ++i) {
+        unsigned num_vars = 150;
+        clauses_t clauses;
+        mk_random_3sat(r, num_vars, num_vars * 426 / 100, clauses);
+        unsigned reused = 0;
+        lbool expected = check_reuse_trail(num_vars, clauses, false, reused);
+        ENSURE(reused == 0);
+        ENSURE(check_reuse_trail(num_vars, clauses, true, reused) == expected);
+        total += reused;
+    }
+    // the next decision is an unassigned variable, so levels whose decisions
+    // are more active than it are kept.
+    ENSURE(total > 0);
+}
@@ -0,0 +1,54 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    simplify_tactic.cpp
+
+Abstract:
+
+    Check that simplification on several threads produces the same goal
+    as sequential simplification.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/ast_pp.h"
+#include "tactic/core/simplify_tactic.h"
+
+static void simplify(goal_ref & g, unsigned threads) {
+    ast_manager & m = g->m();
+    params_ref p;
+    p.set_uint("simplify.threads", threads);
+    p.set_uint("simplify.min_parallel_size", 1);
+    tactic_ref t = mk_simplify_tactic(m, p);
+    goal_ref_buffer result;
+    (*t)(g, result);
+    ENSURE(result.size() == 1);
+    g = result[0];
+}
+
+void tst_simplify_tactic() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref c(m.mk_const(symbol("c"), a.mk_int()), m);
+    goal_ref g1 = alloc(goal, m), g2 = alloc(goal, m);
+    // the formulas only share the constant c and numerals, so they can be simplified in separate parts.
+    for (unsigned i = 0; i < 50; ++i) {
+        expr_ref x(m.mk_const(symbol(i), a.mk_int()), m);
+        expr_ref f(a.mk_gt(a.mk_mul(a.mk_add(x, c, a.mk_int(0)), a.mk_int(1)), a.mk_add(a.mk_int(i), a.mk_int(2))), m);
+        g1->assert_expr(f);
+        g2->assert_expr(f);
+    }
+    simplify(g1, 1);
+    simplify(g2, 4);
+    ENSURE(g1->size() == g2->size());
+    for (unsigned i = 0; i < g1->size(); ++i) {
+        if (g1->form(i) != g2->form(i)) {
+            std::cout << mk_pp(g1->form(i), m) << "\n" << mk_pp(g2->form(i), m) << "\n";
+            ENSURE(false);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    smt_kernel.cpp
+
+Abstract:
+
+    Check that smt::kernel::reset erases assertions with and without
+    smt.fast_reset, and that the context is set up with the static
+    features of the assertions after a reset.
+
+    smt_kernel_reset_latency [rounds] measures the latency of reset
+    followed by a trivial check.
+
+--*/
+
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "util/stopwatch.h"
+#include <iostream>
+#include "test/test_util.h"
+
+static void reset_and_check(ast_manager & m, bool fast_reset, unsigned rounds) {
+    arith_util a(m);
+    smt_params fp;
+    params_ref p;
+    p.set_bool("fast_reset", fast_reset);
+    smt::kernel solver(m, fp, p);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    for (unsigned i = 0; i < rounds; ++i) {
+        solver.reset();
+        ENSURE(solver.get_scope_level() == 0);
+        solver.assert_expr(a.mk_le(x, a.mk_int(i)));
+        solver.assert_expr(a.mk_ge(x, y));
+        // the assertions of the previous round are gone.
+        ENSURE(solver.check() == l_true);
+        solver.push();
+        solver.assert_expr(a.mk_gt(y, a.mk_int(i)));
+        ENSURE(solver.check() == l_false);
+        solver.pop(1);
+        ENSURE(solver.get_scope_level() == 0);
+    }
+    ENSURE(get_stat(solver, "smt fast resets") == (fast_reset ? rounds - 1 : 0));
+}
+
+// the static features of difference constraints select the difference logic solver.
+static void check_static_features(ast_manager & m, bool fast_reset) {
+    arith_util a(m);
+    smt_params fp;
+    params_ref p;
+    p.set_bool("fast_reset", fast_reset);
+    smt::kernel solver(m, fp, p);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref z(m.mk_const(symbol("z"), a.mk_int()), m);
+    solver.reset();
+    solver.assert_expr(a.mk_le(a.mk_sub(x, y), a.mk_int(2)));
+    solver.assert_expr(a.mk_le(a.mk_sub(y, z), a.mk_int(-3)));
+    solver.assert_expr(a.mk_le(a.mk_sub(z, x), a.mk_int(0)));
+    ENSURE(solver.setup_and_check() == l_false);
+    // the integer difference logic setup turns off relevancy.
+    ENSURE(fp.m_relevancy_lvl == 0);
+}
+
+static double reset_latency(ast_manager & m, bool fast_reset, unsigned rounds) {
+    arith_util a(m);
+    smt_params fp;
+    params_ref p;
+    p.set_bool("fast_reset", fast_reset);
+    smt::kernel solver(m, fp, p);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < rounds; ++i) {
+        solver.reset();
+        solver.assert_expr(a.mk_le(x, a.mk_int(i)));
+        ENSURE(solver.check() == l_true);
+    }
+    sw.stop();
+    return sw.get_seconds();
+}
+
+void tst_smt_kernel_reset_latency(char ** argv, int argc, int & i) {
+    unsigned rounds = 1000;
+    if (i + 1 < argc) {
+        rounds = atoi(argv[i + 1]);
+        ++i;
+    }
+    ast_manager m;
+    reg_decl_plugins(m);
+    double slow = reset_latency(m, false, rounds);
+    double fast = reset_latency(m, true, rounds);
+    std::cout << "reset + check, rebuilt context: " << (slow * 1000000 / rounds) << " us\n";
+    std::cout << "reset + check, fast reset:      " << (fast * 1000000 / rounds) << " us\n";
+}
+
+void tst_smt_kernel() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    reset_and_check(m, false, 20);
+    reset_and_check(m, true, 20);
+    check_static_features(m, false);
+    check_static_features(m, true);
+}
@@ -0,0 +1,126 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    solve_eqs.cpp
+
+Abstract:
+
+    Check the dependencies that solve-eqs attaches to the formulas it
+    rewrites when unsat cores are enabled.
+
+    solve_eqs_chain [n] measures solve-eqs on a chain of n definitions
+    x_{i+1} = f(x_i, t) that share a term t of depth n, with and without
+    unsat cores.
+
+--*/
+
+#include <iostream>
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "tactic/tactic.h"
+#include "tactic/core/solve_eqs_tactic.h"
+#include "util/stopwatch.h"
+
+static expr_ref mk_bool(ast_manager & m, char const * prefix, unsigned i) {
+    std::string name = prefix + std::to_string(i);
+    return expr_ref(m.mk_const(symbol(name.c_str()), m.mk_bool_sort()), m);
+}
+
+// x_{i+1} = x_i + 1 for i < n under assumption a_i, y = z + 1 under b
+// and x_n <= x_0 under c. The goal is inconsistent with a core of
+// c and all a_i.
+static void check_core(unsigned n) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    goal_ref g = alloc(goal, m, false, false, true);
+    expr_ref_vector xs(m), as(m);
+    for (unsigned i = 0; i <= n; ++i) {
+        std::string name = "x" + std::to_string(i);
+        xs.push_back(m.mk_const(symbol(name.c_str()), a.mk_int()));
+    }
+    for (unsigned i = 0; i < n; ++i) {
+        as.push_back(mk_bool(m, "a", i));
+        g->assert_expr(m.mk_eq(xs.get(i + 1), a.mk_add(xs.get(i), a.mk_int(1))), as.get(i));
+    }
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref z(m.mk_const(symbol("z"), a.mk_int()), m);
+    expr_ref b = mk_bool(m, "b", 0);
+    expr_ref c = mk_bool(m, "c", 0);
+    g->assert_expr(m.mk_eq(y, a.mk_add(z, a.mk_int(1))), b);
+    g->assert_expr(a.mk_le(xs.get(n), xs.get(0)), c);
+    tactic_ref t = mk_solve_eqs_tactic(m);
+    goal_ref_buffer result;
+    (*t)(g, result);
+    ENSURE(result.size() == 1);
+    goal * r = result[0];
+    ENSURE(r->inconsistent());
+    expr_dependency * d = nullptr;
+    for (unsigned i = 0; i < r->size(); ++i)
+        if (m.is_false(r->form(i)))
+            d = r->dep(i);
+    ptr_vector<expr> deps;
+    m.linearize(d, deps);
+    ENSURE(deps.contains(c));
+    for (expr * ai : as)
+        ENSURE(deps.contains(ai));
+    ENSURE(!deps.contains(b));
+}
+
+static double solve_chain(unsigned n, bool cores) {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    sort * i = a.mk_int();
+    sort * ii[2] = { i, i };
+    func_decl_ref f(m.mk_func_decl(symbol("f"), 2, ii, i), m);
+    func_decl_ref h(m.mk_func_decl(symbol("h"), i, i), m);
+    func_decl_ref p(m.mk_func_decl(symbol("p"), i, m.mk_bool_sort()), m);
+    goal_ref g = alloc(goal, m, false, false, cores);
+    // a term of depth n shared by all definitions.
+    expr_ref t(m.mk_const(symbol("y"), i), m);
+    for (unsigned j = 0; j < n; ++j)
+        t = m.mk_app(h, t.get());
+    expr_ref_vector xs(m);
+    for (unsigned j = 0; j <= n; ++j) {
+        std::string name = "x" + std::to_string(j);
+        xs.push_back(m.mk_const(symbol(name.c_str()), i));
+    }
+    for (unsigned j = 0; j < n; ++j) {
+        expr * eq = m.mk_eq(xs.get(j + 1), m.mk_app(f, xs.get(j), t.get()));
+        if (cores)
+            g->assert_expr(eq, mk_bool(m, "a", j));
+        else
+            g->assert_expr(eq);
+    }
+    g->assert_expr(m.mk_app(p, xs.get(n)));
+    tactic_ref st = mk_solve_eqs_tactic(m);
+    goal_ref_buffer result;
+    stopwatch sw;
+    sw.start();
+    (*st)(g, result);
+    sw.stop();
+    ENSURE(result.size() == 1 && result[0]->size() == 1);
+    return sw.get_seconds();
+}
+
+void tst_solve_eqs_chain(char ** argv, int argc, int & i) {
+    unsigned n = 4000;
+    if (i + 1 < argc) {
+        n = atoi(argv[i + 1]);
+        ++i;
+    }
+    for (unsigned k = n / 4; k <= n; k *= 2) {
+        double plain = solve_chain(k, false);
+        double cores = solve_chain(k, true);
+        std::cout << "chain " << k << ": " << plain << " s, with cores: " << cores << " s\n";
+    }
+}
+
+void tst_solve_eqs() {
+    check_core(1);
+    check_core(5);
+    solve_chain(50, true);
+}
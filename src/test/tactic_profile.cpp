@@ -0,0 +1,75 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    tactic_profile.cpp
+
+Abstract:
+
+    Check the goal sizes reported by the JSON output of tactic_profiler
+    for a tactic that creates subgoals.
+
+--*/
+
+#include <sstream>
+#include "ast/reg_decl_plugins.h"
+#include "tactic/tactic.h"
+#include "tactic/tactical.h"
+#include "tactic/core/split_clause_tactic.h"
+
+static bool contains(std::string const & s, std::string const & sub) {
+    return s.find(sub) != std::string::npos;
+}
+
+void tst_tactic_profile() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    expr_ref a(m.mk_const(symbol("a"), m.mk_bool_sort()), m);
+    expr_ref b(m.mk_const(symbol("b"), m.mk_bool_sort()), m);
+    expr_ref c(m.mk_const(symbol("c"), m.mk_bool_sort()), m);
+    goal_ref g = alloc(goal, m);
+    g->assert_expr(m.mk_or(a, m.mk_and(b, c)));
+    unsigned before = g->num_exprs();
+    tactic_ref t = mk_split_clause_tactic();
+    goal_ref_buffer result;
+    std::ostringstream out;
+    {
+        tactic_profiler profiler;
+        exec(*t, g, result);
+        profiler.display_json(out);
+    }
+    ENSURE(result.size() == 2);
+    unsigned after = 0;
+    for (goal * r : result)
+        after += r->num_exprs();
+    // split-clause leaves the input goal unchanged, so its size is not the result size.
+    ENSURE(after != before);
+    std::string json = out.str();
+    // the outermost step is measured on the two subgoals.
+    std::ostringstream expected;
+    expected << "{\"tactic\": \"tactic\", \"calls\": 1";
+    ENSURE(contains(json, expected.str()));
+    expected.str("");
+    expected << "\"exprs-before\": " << before << ", \"exprs-after\": " << after << ",";
+    ENSURE(contains(json, expected.str()));
+    // split-clause only reports on its input goal.
+    ENSURE(contains(json, "{\"tactic\": \"split-clause\", \"calls\": 1"));
+    ENSURE(contains(json, "\"goal-exprs-after\": "));
+
+    // tacticals are measured on their subgoals as well.
+    tactic_ref t2 = cond(mk_const_probe(1), mk_split_clause_tactic(), mk_skip_tactic());
+    result.reset();
+    out.str("");
+    {
+        tactic_profiler profiler;
+        exec(*t2, g, result);
+        profiler.display_json(out);
+    }
+    json = out.str();
+    size_t i = json.find("{\"tactic\": \"cond\"");
+    ENSURE(i != std::string::npos);
+    std::string cond_json = json.substr(i, json.find('\n', i) - i);
+    ENSURE(contains(cond_json, expected.str()));
+    ENSURE(!contains(cond_json, "goal-exprs-after"));
+}
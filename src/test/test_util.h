@@ -6,7 +6,10 @@ Copyright (c) 2015 Microsoft Corporation
 
 #pragma once
 
+#include <cstring>
 #include "util/stopwatch.h"
+#include "util/statistics.h"
+#include "api/z3.h"
 
 struct test_context {
     bool test_ok;
@@ -18,6 +21,31 @@ struct test_context {
     test_context() : fails(0) {}
 };
 
+// sum of the unsigned values reported for key, 0 if key is not reported.
+inline unsigned get_stat(statistics const & st, char const * key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < st.size(); ++i)
+        if (st.is_uint(i) && strcmp(st.get_key(i), key) == 0)
+            r += st.get_uint_value(i);
+    return r;
+}
+
+// statistic of an object that provides collect_statistics.
+template<typename T>
+unsigned get_stat(T const & t, char const * key) {
+    statistics st;
+    t.collect_statistics(st);
+    return get_stat(st, key);
+}
+
+inline unsigned get_stat(Z3_context ctx, Z3_stats st, char const * key) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < Z3_stats_size(ctx, st); ++i)
+        if (Z3_stats_is_uint(ctx, st, i) && strcmp(Z3_stats_get_key(ctx, st, i), key) == 0)
+            r += Z3_stats_get_uint_value(ctx, st, i);
+    return r;
+}
+
 #undef min
 #undef max
 
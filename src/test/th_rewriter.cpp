@@ -0,0 +1,79 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    th_rewriter.cpp
+
+Abstract:
+
+    Check when the persistent cache of th_rewriter (rewriter.cache_persistent)
+    survives reset() and when it is flushed.
+
+--*/
+
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "test/test_util.h"
+
+// rewrite t and check that the cache is filled.
+static void fill_cache(th_rewriter & rw, expr * t) {
+    expr_ref r(rw.m());
+    rw(t, r);
+    rw.reset();
+    ENSURE(rw.get_cache_size() > 0);
+}
+
+void tst_th_rewriter() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref t(a.mk_le(a.mk_add(a.mk_mul(a.mk_int(2), x), a.mk_add(y, a.mk_int(1))), a.mk_int(3)), m);
+    expr_ref r(m);
+    params_ref p;
+    p.set_bool("cache_all", true);
+    p.set_bool("cache_persistent", true);
+
+    // the cache survives reset() and is used by the next call.
+    th_rewriter rw(m, p);
+    fill_cache(rw, t);
+    unsigned size = rw.get_cache_size();
+    unsigned hits = get_stat(rw, "rewriter cache hits");
+    rw(t, r);
+    rw.reset();
+    ENSURE(rw.get_cache_size() == size);
+    ENSURE(get_stat(rw, "rewriter cache hits") > hits);
+
+    // updating parameters flushes the cache.
+    rw.updt_params(p);
+    ENSURE(rw.get_cache_size() == 0);
+    fill_cache(rw, t);
+
+    // so does installing a substitution or a solver.
+    rw.set_substitution(nullptr);
+    ENSURE(rw.get_cache_size() == 0);
+    fill_cache(rw, t);
+    rw.set_solver(nullptr);
+    ENSURE(rw.get_cache_size() == 0);
+    fill_cache(rw, t);
+
+    // results computed under bindings do not survive reset().
+    expr_ref v(m.mk_var(0, a.mk_int()), m);
+    expr_ref body(a.mk_le(a.mk_add(v, a.mk_int(1)), y), m);
+    expr * binding = x;
+    rw(body, 1, &binding);
+    rw.reset();
+    ENSURE(rw.get_cache_size() == 0);
+
+    // without the parameter, reset() flushes the cache.
+    params_ref p2;
+    p2.set_bool("cache_all", true);
+    th_rewriter rw2(m, p2);
+    rw2(t, r);
+    ENSURE(rw2.get_cache_size() > 0);
+    rw2.reset();
+    ENSURE(rw2.get_cache_size() == 0);
+}
@@ -0,0 +1,110 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    theory_diff_logic.cpp
+
+Abstract:
+
+    Check that propagation of implied edges in the sparse difference
+    logic solver (smt.arith.dl_implied_edges) does not change results on
+    small scheduling problems, and that the explanations of implied edges
+    give correct unsat cores.
+
+--*/
+
+#include "smt/smt_kernel.h"
+#include "smt/params/smt_params.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "test/test_util.h"
+
+// jobs with the given durations run on one machine and finish before the horizon.
+// The deadlines of the jobs are assumptions.
+static lbool schedule(ast_manager & m, unsigned num_jobs, unsigned horizon, bool implied_edges, bound_prop_mode mode) {
+    arith_util a(m);
+    smt_params fp;
+    fp.m_auto_config = false;
+    fp.m_arith_mode = arith_solver_id::AS_DIFF_LOGIC;
+    fp.m_arith_bound_prop = mode;
+    fp.m_arith_dl_implied_edges = implied_edges;
+    smt::kernel solver(m, fp);
+    expr_ref_vector start(m);
+    for (unsigned i = 0; i < num_jobs; ++i)
+        start.push_back(m.mk_const(symbol(i), a.mk_int()));
+    auto duration = [&](unsigned i) { return 1 + (3 * i) % 5; };
+    expr_ref_vector deadlines(m);
+    for (unsigned i = 0; i < num_jobs; ++i) {
+        solver.assert_expr(a.mk_ge(start.get(i), a.mk_int(0)));
+        deadlines.push_back(a.mk_le(start.get(i), a.mk_int(horizon - duration(i))));
+        for (unsigned j = i + 1; j < num_jobs; ++j) {
+            expr_ref i_before_j(a.mk_le(a.mk_sub(start.get(i), start.get(j)), a.mk_int(-(int)duration(i))), m);
+            expr_ref j_before_i(a.mk_le(a.mk_sub(start.get(j), start.get(i)), a.mk_int(-(int)duration(j))), m);
+            solver.assert_expr(m.mk_or(i_before_j, j_before_i));
+        }
+    }
+    lbool r = solver.check(deadlines.size(), deadlines.c_ptr());
+    ENSURE(get_stat(solver, "dl asserts") > 0);
+    if (!implied_edges || mode == bound_prop_mode::BP_NONE)
+        ENSURE(get_stat(solver, "dl propagations") == 0);
+    if (r == l_false) {
+        // the core is derived from explanations, including those of propagated edges.
+        expr_ref_vector core(m);
+        for (unsigned i = 0; i < solver.get_unsat_core_size(); ++i)
+            core.push_back(solver.get_unsat_core_expr(i));
+        ENSURE(solver.check(core.size(), core.c_ptr()) == l_false);
+    }
+    return r;
+}
+
+// x - y <= 0 implies x - y <= 3, and together with y - z <= 0 it implies x - z <= 2.
+// The implied edge is excluded by clauses over p that only conflict once it is
+// assigned, so the core contains the assumptions explaining the propagation.
+static void check_implied_edge(ast_manager & m, bound_prop_mode mode) {
+    arith_util a(m);
+    smt_params fp;
+    fp.m_auto_config = false;
+    fp.m_arith_mode = arith_solver_id::AS_DIFF_LOGIC;
+    fp.m_arith_bound_prop = mode;
+    fp.m_arith_dl_implied_edges = true;
+    smt::kernel solver(m, fp);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    expr_ref z(m.mk_const(symbol("z"), a.mk_int()), m);
+    expr_ref p(m.mk_const(symbol("p"), m.mk_bool_sort()), m);
+    expr_ref xy0(a.mk_le(a.mk_sub(x, y), a.mk_int(0)), m);
+    expr_ref yz0(a.mk_le(a.mk_sub(y, z), a.mk_int(0)), m);
+    bool refine = mode == bound_prop_mode::BP_REFINE;
+    expr_ref implied(refine ? a.mk_le(a.mk_sub(x, z), a.mk_int(2)) : a.mk_le(a.mk_sub(x, y), a.mk_int(3)), m);
+    solver.assert_expr(m.mk_or(m.mk_not(implied), p));
+    solver.assert_expr(m.mk_or(m.mk_not(implied), m.mk_not(p)));
+    expr_ref_vector asms(m);
+    asms.push_back(xy0);
+    asms.push_back(yz0);
+    ENSURE(solver.check(asms.size(), asms.c_ptr()) == l_false);
+    ENSURE(get_stat(solver, "dl propagations") > 0);
+    expr_ref_vector core(m);
+    for (unsigned i = 0; i < solver.get_unsat_core_size(); ++i)
+        core.push_back(solver.get_unsat_core_expr(i));
+    ENSURE(core.contains(xy0));
+    ENSURE(core.contains(yz0) == refine);
+    ENSURE(solver.check(core.size(), core.c_ptr()) == l_false);
+}
+
+void tst_theory_diff_logic() {
+    ast_manager m;
+    reg_decl_plugins(m);
+    unsigned num_jobs = 6;
+    unsigned total = 0;
+    for (unsigned i = 0; i < num_jobs; ++i)
+        total += 1 + (3 * i) % 5;
+    for (unsigned horizon = total - 2; horizon <= total + 1; ++horizon) {
+        lbool expected = horizon >= total ? l_true : l_false;
+        ENSURE(schedule(m, num_jobs, horizon, false, bound_prop_mode::BP_REFINE) == expected);
+        ENSURE(schedule(m, num_jobs, horizon, true, bound_prop_mode::BP_SIMPLE) == expected);
+        ENSURE(schedule(m, num_jobs, horizon, true, bound_prop_mode::BP_REFINE) == expected);
+    }
+    check_implied_edge(m, bound_prop_mode::BP_SIMPLE);
+    check_implied_edge(m, bound_prop_mode::BP_REFINE);
+}
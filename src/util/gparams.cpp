@@ -478,6 +478,15 @@ public:
         return m_params;
     }
 
+    void display_updated(std::ostream & out) {
+        lock_guard lock(*gparams_mux);
+        m_params.display(out);
+        for (auto & kv : m_module_params) {
+            out << kv.m_key << ":";
+            kv.m_value->display(out);
+        }
+    }
+
     // -----------------------------------------------
     //
     // Pretty printing
@@ -620,6 +629,11 @@ params_ref const& gparams::get_ref() {
     return g_imp->get_ref();
 }
 
+void gparams::display_updated(std::ostream & out) {
+    SASSERT(g_imp);
+    g_imp->display_updated(out);
+}
+
 void gparams::display(std::ostream & out, unsigned indent, bool smt2_style, bool include_descr) {
     SASSERT(g_imp);
     g_imp->display(out, indent, smt2_style, include_descr);
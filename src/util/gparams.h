@@ -108,6 +108,11 @@ public:
 
     static params_ref const& get_ref();
 
+    /**
+       \brief Display the values of the global and module parameters that were set.
+    */
+    static void display_updated(std::ostream & out);
+
     /**
        \brief Dump information about available parameters in the given output stream.
     */